@@ -0,0 +1,1234 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "s21_containers.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Время выполнения функции в секундах.
+template <typename F>
+double Measure(F &&func) {
+  auto start = Clock::now();
+  func();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief Вывод строки результата.
+void Report(const char *name, double seconds, std::size_t ops) {
+  printf("  %-44s %10.2f ms %14.0f ops/s\n", name, seconds * 1e3,
+         ops / seconds);
+}
+
+/// @brief Объём занятой кучи в байтах (0, если неизвестен).
+std::size_t HeapInUse() {
+#ifdef __GLIBC__
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+/// @brief Слова файла в порядке следования.
+std::vector<std::string> FileWords(const std::string &path) {
+  const char *delimiters = " \n\t,.:;!?-()[]{}'\"";
+  std::ifstream file(path);
+  std::string str;
+  std::vector<std::string> words;
+  while (getline(file, str)) {
+    char *word = strtok((char *)str.data(), delimiters);
+    while (word != nullptr) {
+      words.emplace_back(word);
+      word = strtok(nullptr, delimiters);
+    }
+  }
+  return words;
+}
+
+/// @brief Файл из test.txt, повторённого scale раз.
+std::string ScaledTestTxt(int scale) {
+  std::ifstream in("test.txt", std::ios::binary);
+  std::string text((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  std::string path = "bench_input.txt";
+  std::ofstream out(path, std::ios::binary);
+  for (int i = 0; i < scale; ++i) out << text;
+  return path;
+}
+
+/// @brief Случайные слова из строчных латинских букв.
+std::vector<std::string> RandomWords(std::size_t count, int min_len,
+                                     int max_len, unsigned seed = 21) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> len(min_len, max_len);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::vector<std::string> words(count);
+  for (auto &word : words) {
+    word.resize(len(gen));
+    for (auto &c : word) c = static_cast<char>(letter(gen));
+  }
+  return words;
+}
+
+void BenchLoader() {
+  const int scale = 400;
+  std::string path = ScaledTestTxt(scale);
+  printf("loader: test.txt x %d\n", scale);
+  const char *delimiters = " \n\t,.:;!?-()[]{}'\"";
+  std::size_t words = 0;
+  double seconds = Measure([&] {
+    std::ifstream file(path);
+    std::string str;
+    s21::multiset<std::string> s21;
+    while (getline(file, str)) {
+      char *word = strtok((char *)str.data(), delimiters);
+      while (word != nullptr) {
+        s21.insert(word);
+        word = strtok(nullptr, delimiters);
+      }
+    }
+    words = s21.size();
+  });
+  Report("getline + strtok + multiset::insert", seconds, words);
+  for (unsigned threads : {1u, 2u, 4u, 8u}) {
+    s21::LoadOptions options;
+    options.threads = threads;
+    char name[64];
+    snprintf(name, sizeof(name), "load_multiset, %u threads", threads);
+    Report(name, Measure([&] { s21::load_multiset(path, options); }), words);
+    snprintf(name, sizeof(name), "load_set, %u threads", threads);
+    Report(name, Measure([&] { s21::load_set(path, options); }), words);
+  }
+  std::remove(path.c_str());
+}
+
+void BenchStrings() {
+  const std::size_t count = 1000000;
+  for (int max_len : {12, 32}) {
+    std::vector<std::string> words = RandomWords(count, 3, max_len);
+    std::vector<std::string> probes = words;
+    std::shuffle(probes.begin(), probes.end(), std::mt19937(7));
+    printf("strings: %zu random words, length 3..%d\n", count, max_len);
+    s21::set<std::string> s21;
+    s21::string_set inl;
+    Report("set<std::string>::insert",
+           Measure([&] { for (const auto &w : words) s21.insert(w); }), count);
+    Report("string_set::insert",
+           Measure([&] { for (const auto &w : words) inl.insert(w); }), count);
+    std::size_t found = 0;
+    Report("set<std::string>::contains", Measure([&] {
+             for (const auto &w : probes) found += s21.contains(w);
+           }),
+           count);
+    Report("string_set::contains", Measure([&] {
+             for (const auto &w : probes) found += inl.contains(w);
+           }),
+           count);
+    std::size_t bytes = 0;
+    Report("set<std::string> iteration", Measure([&] {
+             for (const auto &w : s21) bytes += w.size();
+           }),
+           s21.size());
+    Report("string_set iteration", Measure([&] {
+             for (auto w : inl) bytes += w.size();
+           }),
+           inl.size());
+    printf("  string_set arena: %zu KiB, found %zu, bytes %zu\n",
+           inl.arena_bytes() / 1024, found, bytes);
+  }
+}
+
+void BenchWordCount() {
+  const int scale = 400;
+  std::string path = ScaledTestTxt(scale);
+  std::vector<std::string> words = FileWords(path);
+  std::remove(path.c_str());
+  printf("word count: %zu tokens (test.txt x %d)\n", words.size(), scale);
+  std::size_t before = HeapInUse();
+  auto *s21 = new s21::multiset<std::string>;
+  Report("multiset<std::string>::insert",
+         Measure([&] { for (const auto &w : words) s21->insert(w); }),
+         words.size());
+  std::size_t multiset_heap = HeapInUse() - before;
+  before = HeapInUse();
+  auto *counted = new s21::string_multiset;
+  Report("string_multiset::insert",
+         Measure([&] { for (const auto &w : words) counted->insert(w); }),
+         words.size());
+  std::size_t counted_heap = HeapInUse() - before;
+  std::vector<std::string> distinct;
+  for (auto entry : *counted) distinct.emplace_back(entry.first);
+  std::size_t total = 0;
+  Report("multiset<std::string>::count", Measure([&] {
+           for (const auto &w : distinct) total += s21->count(w);
+         }),
+         distinct.size());
+  Report("string_multiset::count", Measure([&] {
+           for (const auto &w : distinct) total += counted->count(w);
+         }),
+         distinct.size());
+  Report("string_multiset::top(10)", Measure([&] { counted->top(10); }), 1);
+  printf("  heap: multiset<std::string> %zu KiB, string_multiset %zu KiB\n",
+         multiset_heap / 1024, counted_heap / 1024);
+  printf("  counted %zu tokens\n", total);
+  delete s21;
+  delete counted;
+}
+
+/// @brief Компаратор только с operator<: дерево сравнивает дважды на уровень.
+template <typename T>
+struct PlainLess {
+  bool operator()(const T &a, const T &b) const { return a < b; }
+};
+
+/// @brief Вставка и поиск всех ключей в контейнере типа Set. Контейнер
+/// возвращается, чтобы следующий замер не переиспользовал его узлы: иначе
+/// локальность кучи искажает сравнение.
+template <typename Set, typename T>
+std::unique_ptr<Set> BenchLookup(const char *name, const std::vector<T> &keys) {
+  auto set = std::make_unique<Set>();
+  char label[64];
+  snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] { for (const auto &k : keys) set->insert(k); }),
+         keys.size());
+  std::size_t found = 0;
+  snprintf(label, sizeof(label), "%s contains", name);
+  Report(label, Measure([&] {
+           for (const auto &k : keys) found += set->contains(k);
+         }),
+         keys.size());
+  if (found != keys.size()) printf("  unexpected: found %zu\n", found);
+  return set;
+}
+
+void BenchCompare() {
+  const std::size_t count = 1000000;
+  std::vector<std::string> words = RandomWords(count, 4, 24);
+  std::mt19937 gen(5);
+  std::vector<int> ints(count);
+  for (auto &k : ints) k = static_cast<int>(gen());
+  printf("compare: %zu keys, two-way vs three-way descent\n", count);
+  auto s1 = BenchLookup<s21::set<std::string, PlainLess<std::string>>>(
+      "set<string>, operator< only", words);
+  auto s2 = BenchLookup<s21::set<std::string>>(
+      "set<string>, std::less (compare)", words);
+  auto s3 = BenchLookup<s21::set<int, PlainLess<int>>>(
+      "set<int>, operator< only", ints);
+  auto s4 = BenchLookup<s21::set<int>>("set<int>, std::less (branchless)",
+                                       ints);
+  std::vector<int> dups(count);
+  for (auto &k : dups) k = static_cast<int>(gen() % 64);
+  s21::multiset<int> multi;
+  Report("multiset<int>::insert, 64 distinct keys",
+         Measure([&] { for (int k : dups) multi.insert(k); }), count);
+}
+
+void BenchMoves() {
+  const std::size_t count = 200000;
+  std::vector<std::string> words = RandomWords(count, 200, 200);
+  printf("moves: %zu heavy keys (200-byte strings)\n", count);
+  s21::set<std::string> copied;
+  Report("set<string>::insert(const&)",
+         Measure([&] { for (const auto &w : words) copied.insert(w); }),
+         count);
+  std::vector<std::string> pool = words;
+  s21::set<std::string> moved;
+  Report("set<string>::insert(&&)", Measure([&] {
+           for (auto &w : pool) moved.insert(std::move(w));
+         }),
+         count);
+  s21::set<std::vector<char>> emplaced;
+  Report("set<vector<char>>::emplace(first, last)", Measure([&] {
+           for (const auto &w : words) emplaced.emplace(w.begin(), w.end());
+         }),
+         count);
+  pool = words;
+  s21::multiset<std::string> many;
+  Report("multiset<string>::insert_many(&&...)", Measure([&] {
+           for (std::size_t i = 0; i + 4 <= count; i += 4) {
+             many.insert_many(std::move(pool[i]), std::move(pool[i + 1]),
+                              std::move(pool[i + 2]), std::move(pool[i + 3]));
+           }
+         }),
+         count);
+}
+
+/// @brief Параметры дерева со сбором статистики.
+struct Counted : s21::TreeOptions {
+  using stats_policy = s21::TreeStats;
+};
+
+void BenchFinger() {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(11);
+  std::vector<int> keys(count);
+  for (auto &k : keys) k = static_cast<int>(gen() % (4 * count));
+  std::sort(keys.begin(), keys.end());
+  s21::set<int, std::less<int>, Counted> set;
+  set.assign_sorted(keys.begin(), keys.end());
+  printf("finger: set of %zu ints, sorted probe batches\n", set.size());
+  for (std::size_t k : {count / 1000, count / 16, count / 4, count}) {
+    std::vector<int> batch(k);
+    for (auto &key : batch) key = static_cast<int>(gen() % (4 * count));
+    std::sort(batch.begin(), batch.end());
+    char name[64];
+    std::size_t hits = 0;
+    set.reset_stats();
+    snprintf(name, sizeof(name), "k=%zu, contains x k", k);
+    Report(name, Measure([&] {
+             for (int key : batch) hits += set.contains(key);
+           }),
+           k);
+    double independent = set.stats().comparisons / static_cast<double>(k);
+    set.reset_stats();
+    snprintf(name, sizeof(name), "k=%zu, contains_sorted_batch", k);
+    Report(name, Measure([&] {
+             auto res = set.contains_sorted_batch(batch.begin(), batch.end());
+             hits += std::count(res.begin(), res.end(), true);
+           }),
+           k);
+    printf("  comparisons per key: %.1f independent, %.1f batch (hits %zu)\n",
+           independent, set.stats().comparisons / static_cast<double>(k),
+           hits);
+    auto copy1 = set;
+    auto copy2 = set;
+    snprintf(name, sizeof(name), "k=%zu, insert x k", k);
+    Report(name, Measure([&] { for (int key : batch) copy1.insert(key); }),
+           k);
+    snprintf(name, sizeof(name), "k=%zu, insert_sorted_batch", k);
+    Report(name, Measure([&] {
+             copy2.insert_sorted_batch(batch.begin(), batch.end());
+           }),
+           k);
+  }
+}
+
+/// @brief Статистика и балансировка AVL.
+struct CountedAVL : Counted {
+  using balance_policy = s21::AVLBalance;
+};
+
+/// @brief Вставка, поиск и удаление случайных ключей для политики Options.
+template <typename Options>
+std::unique_ptr<s21::set<int, std::less<int>, Options>> BenchBalance(
+    const char *name, const std::vector<int> &keys,
+    const std::vector<int> &probes) {
+  auto set = std::make_unique<s21::set<int, std::less<int>, Options>>();
+  char label[64];
+  snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] { for (int k : keys) set->insert(k); }),
+         keys.size());
+  auto stats = set->stats();
+  printf("  %s: rotations %zu, avg insert depth %.2f\n", name,
+         stats.rotations, stats.AverageDepth());
+  set->reset_stats();
+  std::size_t found = 0;
+  snprintf(label, sizeof(label), "%s contains", name);
+  Report(label, Measure([&] {
+           for (int k : probes) found += set->contains(k);
+         }),
+         probes.size());
+  printf("  %s: avg lookup depth %.2f, found %zu\n", name,
+         set->stats().AverageDepth(), found);
+  return set;
+}
+
+void BenchBalancePolicies() {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(3);
+  std::vector<int> random(count), sequential(count), probes(count);
+  for (auto &k : random) k = static_cast<int>(gen());
+  std::iota(sequential.begin(), sequential.end(), 0);
+  for (auto &k : probes) k = random[gen() % count];
+  printf("balance: %zu keys, red-black vs AVL\n", count);
+  auto rb1 = BenchBalance<Counted>("random, red-black", random, probes);
+  auto avl1 = BenchBalance<CountedAVL>("random, AVL", random, probes);
+  auto rb2 = BenchBalance<Counted>("sequential, red-black", sequential, probes);
+  auto avl2 = BenchBalance<CountedAVL>("sequential, AVL", sequential, probes);
+}
+
+/// @brief Всплеск удалений и поиск после него: обычное удаление против
+/// ленивого с заданным порогом.
+std::unique_ptr<s21::set<int>> BenchErase(const char *name, double threshold,
+                                          const std::vector<int> &keys,
+                                          const std::vector<int> &victims) {
+  auto set = std::make_unique<s21::set<int>>();
+  set->assign_sorted(keys.begin(), keys.end());
+  set->set_lazy_erase(threshold);
+  char label[64];
+  snprintf(label, sizeof(label), "%s erase", name);
+  Report(label, Measure([&] {
+           for (int k : victims) set->erase(set->find(k));
+         }),
+         victims.size());
+  std::size_t found = 0;
+  snprintf(label, sizeof(label), "%s contains", name);
+  Report(label, Measure([&] {
+           for (int k : keys) found += set->contains(k);
+         }),
+         keys.size());
+  printf("  %s: size %zu, found %zu, dead fraction %.2f\n", name, set->size(),
+         found, set->stats().DeadFraction());
+  return set;
+}
+
+void BenchLazyErase() {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(4);
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<int> victims(keys);
+  std::shuffle(victims.begin(), victims.end(), gen);
+  victims.resize(count * 4 / 10);
+  printf("lazy: %zu keys, erase burst of %zu\n", count, victims.size());
+  auto eager = BenchErase("eager", 0, keys, victims);
+  auto lazy = BenchErase("lazy 0.5", 0.5, keys, victims);
+  Report("lazy 0.5 compact", Measure([&] { lazy->compact(); }), count);
+}
+
+struct Fingerprinted : s21::TreeOptions {
+  using fingerprint_policy = s21::HashFingerprint;
+};
+
+/// @brief Сравнение operator!= двух множеств одного размера, отличающихся
+/// только наибольшим ключом (худший случай обхода), и стоимость поддержки
+/// отпечатка при вставке.
+template <typename Options>
+void BenchInequality(const char *name, const std::vector<int> &keys) {
+  s21::set<int, std::less<int>, Options> a, b;
+  char label[64];
+  snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] { for (int k : keys) a.insert(k); }), keys.size());
+  b = a;
+  b.erase(b.find(*std::max_element(keys.begin(), keys.end())));
+  b.insert(std::numeric_limits<int>::max());
+  const int rounds = 20;
+  std::size_t differ = 0;
+  snprintf(label, sizeof(label), "%s operator!=", name);
+  Report(label, Measure([&] {
+           for (int i = 0; i < rounds; ++i) differ += a != b;
+         }),
+         rounds);
+  printf("  %s: %zu of %d differ\n", name, differ, rounds);
+}
+
+void BenchFingerprint() {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(5);
+  std::vector<int> keys(count);
+  for (auto &k : keys) k = static_cast<int>(gen() >> 1);
+  printf("fingerprint: %zu keys\n", count);
+  BenchInequality<s21::TreeOptions>("plain", keys);
+  BenchInequality<Fingerprinted>("fingerprint", keys);
+}
+
+void BenchParallel() {
+  const std::size_t count = 10000000;
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  s21::set<int> set;
+  set.assign_sorted(keys.begin(), keys.end());
+  printf("parallel: %zu keys, %u cores\n", count,
+         std::thread::hardware_concurrency());
+  Report("split_ranges(64)", Measure([&] { set.split_ranges(64); }), 1);
+  for (unsigned threads : {1u, 2u, 4u, 8u}) {
+    std::atomic<std::size_t> bad = 0;
+    char label[64];
+    snprintf(label, sizeof(label), "parallel_for_each, %u threads", threads);
+    Report(label, Measure([&] {
+             set.parallel_for_each(
+                 [&](int key) {
+                   // проверка "тяжелее" простого чтения: элемент хэшируется
+                   std::uint64_t h = static_cast<std::uint64_t>(key);
+                   for (int i = 0; i < 8; ++i) {
+                     h = h * 0x9e3779b97f4a7c15ull + 1;
+                   }
+                   if (h == 0) ++bad;
+                 },
+                 threads);
+           }),
+           count);
+    printf("  %zu invalid\n", bad.load());
+  }
+}
+
+void BenchViews() {
+  const std::size_t count = 1000000, sparse = 1000;
+  std::mt19937 gen(6);
+  std::vector<int> dense_keys(count), sparse_keys(sparse);
+  std::iota(dense_keys.begin(), dense_keys.end(), 0);
+  for (auto &k : sparse_keys) k = static_cast<int>(gen() % (2 * count));
+  std::sort(sparse_keys.begin(), sparse_keys.end());
+  s21::set<int> dense, few;
+  dense.assign_sorted(dense_keys.begin(), dense_keys.end());
+  few.assign_sorted(sparse_keys.begin(), sparse_keys.end());
+  printf("views: %zu and %zu keys\n", count, few.size());
+  std::size_t found = 0;
+  const int rounds = 20;
+  Report("linear merge intersection", Measure([&] {
+           for (int i = 0; i < rounds; ++i) {
+             auto x = dense.begin(), y = few.begin();
+             while (x != dense.end() && y != few.end()) {
+               if (*x < *y) {
+                 ++x;
+               } else if (*y < *x) {
+                 ++y;
+               } else {
+                 ++found;
+                 ++x;
+                 ++y;
+               }
+             }
+           }
+         }),
+         rounds);
+  Report("intersection_view", Measure([&] {
+           for (int i = 0; i < rounds; ++i) {
+             for (int key : s21::intersection_view(dense, few)) {
+               found += key >= 0;
+             }
+           }
+         }),
+         rounds);
+  Report("materialized union, first 10", Measure([&] {
+           s21::set<int> res(dense);
+           for (int key : few) res.insert(key);
+           auto it = res.begin();
+           for (int i = 0; i < 10; ++i, ++it) found += *it >= 0;
+         }),
+         1);
+  Report("union_view, first 10", Measure([&] {
+           int taken = 0;
+           for (int key : s21::union_view(dense, few)) {
+             found += key >= 0;
+             if (++taken == 10) break;
+           }
+         }),
+         1);
+  printf("  found %zu\n", found);
+}
+
+/// @brief Счётчик промахов dTLB при чтении текущего потока через
+/// perf_event_open (Linux). Если счётчик недоступен (нет прав, виртуальная
+/// машина), Read() возвращает -1.
+class DtlbMisses {
+ public:
+  DtlbMisses() {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  DtlbMisses(const DtlbMisses &) = delete;
+  DtlbMisses &operator=(const DtlbMisses &) = delete;
+
+  ~DtlbMisses() {
+#ifdef __linux__
+    if (fd_ >= 0) close(fd_);
+#endif
+  }
+
+  void Start() {
+#ifdef __linux__
+    if (fd_ < 0) return;
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  long long Read() {
+#ifdef __linux__
+    std::uint64_t count = 0;
+    if (fd_ < 0) return -1;
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd_, &count, sizeof(count)) != sizeof(count)) return -1;
+    return static_cast<long long>(count);
+#else
+    return -1;
+#endif
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+struct HugePages : s21::TreeOptions {
+  using allocation_policy = s21::HugePageArena;
+};
+
+/// @brief Случайный поиск в большом множестве и промахи dTLB за время
+/// поиска.
+template <typename Options>
+void BenchLookups(const char *name, const std::vector<std::int64_t> &keys,
+                  const std::vector<std::int64_t> &probes) {
+  s21::set<std::int64_t, std::less<std::int64_t>, Options> set;
+  char label[64];
+  snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] {
+           for (auto k : keys) set.insert(k);
+         }),
+         keys.size());
+  std::size_t found = 0;
+  DtlbMisses misses;
+  snprintf(label, sizeof(label), "%s contains", name);
+  misses.Start();
+  double seconds = Measure([&] {
+    for (auto k : probes) found += set.contains(k);
+  });
+  long long dtlb = misses.Read();
+  Report(label, seconds, probes.size());
+  if (dtlb < 0) {
+    printf("  %s: found %zu, dTLB misses unavailable\n", name, found);
+  } else {
+    printf("  %s: found %zu, dTLB misses %.2f per lookup\n", name, found,
+           static_cast<double>(dtlb) / probes.size());
+  }
+}
+
+void BenchArena() {
+  const std::size_t count = 4000000;
+  std::mt19937_64 gen(7);
+  std::vector<std::int64_t> keys(count), probes(count);
+  for (auto &k : keys) k = static_cast<std::int64_t>(gen() >> 1);
+  for (auto &k : probes) k = keys[gen() % count];
+  printf("arena: %zu int64 keys, heap nodes vs huge page arena\n", count);
+  BenchLookups<s21::TreeOptions>("heap", keys, probes);
+  BenchLookups<HugePages>("huge page arena", keys, probes);
+}
+
+/// @brief Вставка, поиск, lower_bound и обход для одного движка множества.
+template <typename Set, typename Key>
+void BenchEngine(const char *name, const std::vector<Key> &keys,
+                 const std::vector<Key> &probes) {
+  std::size_t heap = HeapInUse();
+  auto set = std::make_unique<Set>();
+  char label[64];
+  snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] {
+           for (Key k : keys) set->insert(k);
+         }),
+         keys.size());
+  heap = HeapInUse() - heap;
+  std::size_t found = 0;
+  snprintf(label, sizeof(label), "%s contains", name);
+  Report(label, Measure([&] {
+           for (Key k : probes) found += set->contains(k);
+         }),
+         probes.size());
+  snprintf(label, sizeof(label), "%s lower_bound", name);
+  Report(label, Measure([&] {
+           for (Key k : probes) found += set->lower_bound(k) != set->end();
+         }),
+         probes.size());
+  snprintf(label, sizeof(label), "%s iterate", name);
+  Report(label, Measure([&] {
+           for (Key k : *set) found += k & 1;
+         }),
+         set->size());
+  printf("  %s: found %zu, %.1f heap bytes per key\n", name, found,
+         static_cast<double>(heap) / set->size());
+}
+
+void BenchRadix() {
+  const std::size_t count = 1000000;
+  std::mt19937_64 gen(8);
+  std::vector<std::uint32_t> dense(count), dense_probes(count);
+  std::iota(dense.begin(), dense.end(), 0);
+  std::shuffle(dense.begin(), dense.end(), gen);
+  for (auto &k : dense_probes) k = static_cast<std::uint32_t>(gen() % count);
+  std::vector<std::uint64_t> sparse(count), sparse_probes(count);
+  for (auto &k : sparse) k = gen();
+  for (std::size_t i = 0; i < count; ++i) {
+    sparse_probes[i] = i % 2 ? sparse[gen() % count] : gen();
+  }
+  printf("radix: %zu keys, red-black vs adaptive radix tree\n", count);
+  BenchEngine<s21::set<std::uint32_t>>("dense u32, red-black", dense,
+                                       dense_probes);
+  BenchEngine<s21::radix_set<std::uint32_t>>("dense u32, radix", dense,
+                                             dense_probes);
+  BenchEngine<s21::set<std::uint64_t>>("sparse u64, red-black", sparse,
+                                       sparse_probes);
+  BenchEngine<s21::radix_set<std::uint64_t>>("sparse u64, radix", sparse,
+                                             sparse_probes);
+}
+
+void BenchBitmap() {
+  const std::size_t count = 1000000;
+  const std::uint32_t universe = 4000000;
+  std::mt19937 gen(9);
+  std::vector<std::uint32_t> ids(count), other_ids(count), probes(count);
+  for (auto &k : ids) k = gen() % universe;
+  for (auto &k : other_ids) k = gen() % universe;
+  for (auto &k : probes) k = gen() % universe;
+  printf("bitmap: %zu ids in [0, %u)\n", count, universe);
+  std::size_t heap = HeapInUse();
+  s21::set<std::uint32_t> tree, other_tree;
+  Report("set insert", Measure([&] {
+           for (auto k : ids) tree.insert(k);
+         }),
+         count);
+  std::size_t tree_heap = HeapInUse() - heap;
+  for (auto k : other_ids) other_tree.insert(k);
+  heap = HeapInUse();
+  s21::bitmap_set<std::uint32_t> bitmap;
+  Report("bitmap_set insert", Measure([&] {
+           for (auto k : ids) bitmap.insert(k);
+         }),
+         count);
+  std::size_t bitmap_heap = HeapInUse() - heap;
+  std::unique_ptr<s21::bitmap_set<std::uint32_t>> other;
+  Report("bitmap_set from set", Measure([&] {
+           other = std::make_unique<s21::bitmap_set<std::uint32_t>>(
+               other_tree);
+         }),
+         other_tree.size());
+  std::size_t found = 0;
+  Report("set contains", Measure([&] {
+           for (auto k : probes) found += tree.contains(k);
+         }),
+         count);
+  Report("bitmap_set contains", Measure([&] {
+           for (auto k : probes) found += bitmap.contains(k);
+         }),
+         count);
+  Report("set iterate", Measure([&] {
+           for (auto k : tree) found += k & 1;
+         }),
+         tree.size());
+  Report("bitmap_set iterate", Measure([&] {
+           for (auto k : bitmap) found += k & 1;
+         }),
+         bitmap.size());
+  Report("set intersection (merge of iterators)", Measure([&] {
+           for (auto k : s21::intersection_view(tree, other_tree)) {
+             found += k & 1;
+           }
+         }),
+         tree.size());
+  Report("bitmap_set intersect_with", Measure([&] {
+           auto res = bitmap;
+           res.intersect_with(*other);
+           found += res.size();
+         }),
+         bitmap.size());
+  printf("  found %zu, heap bytes per key: set %.1f, bitmap_set %.2f\n",
+         found, static_cast<double>(tree_heap) / tree.size(),
+         static_cast<double>(bitmap_heap) / bitmap.size());
+}
+
+template <unsigned BitsPerKey>
+struct Filtered : s21::TreeOptions {
+  using filter_policy = s21::BasicBloomFilter<BitsPerKey>;
+};
+
+template <typename Options>
+struct WithStats : Options {
+  using stats_policy = s21::TreeStats;
+};
+
+/// @brief Поток contains, в котором промахивается 95% запросов.
+template <typename Options>
+void BenchMisses(const char *name, const std::vector<int> &keys,
+                 const std::vector<int> &probes) {
+  s21::set<int, std::less<int>, Options> set;
+  char label[64];
+  snprintf(label, sizeof(label), "%s insert", name);
+  Report(label, Measure([&] {
+           for (int k : keys) set.insert(k);
+         }),
+         keys.size());
+  std::size_t found = 0;
+  snprintf(label, sizeof(label), "%s contains", name);
+  Report(label, Measure([&] {
+           for (int k : probes) found += set.contains(k);
+         }),
+         probes.size());
+  // доля ложных срабатываний - на отдельном дереве со счётчиками, чтобы
+  // они не влияли на замер
+  s21::set<int, std::less<int>, WithStats<Options>> counted;
+  for (int k : keys) counted.insert(k);
+  for (int k : probes) counted.contains(k);
+  printf("  %s: found %zu, false positive rate %.4f\n", name, found,
+         counted.stats().FilterFalsePositiveRate());
+}
+
+void BenchBloom() {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(10);
+  std::vector<int> keys(count), probes(count * 4);
+  // ключи нечётные, промахи - чётные числа того же диапазона
+  for (auto &k : keys) k = static_cast<int>(gen() >> 2) | 1;
+  for (auto &k : probes) {
+    k = gen() % 100 < 5 ? keys[gen() % count]
+                        : static_cast<int>(gen() >> 2) & ~1;
+  }
+  printf("bloom: %zu keys, %zu lookups, 95%% misses\n", count, probes.size());
+  BenchMisses<s21::TreeOptions>("no filter", keys, probes);
+  BenchMisses<Filtered<10>>("bloom 10 bits/key", keys, probes);
+  BenchMisses<Filtered<16>>("bloom 16 bits/key", keys, probes);
+}
+
+void BenchTopK() {
+  const std::size_t events = 20000000, k = 1000;
+  std::mt19937_64 gen(44);
+  std::vector<std::int64_t> stream(events);
+  for (auto &v : stream) v = static_cast<std::int64_t>(gen() >> 1);
+  printf("topk: %zu events, k = %zu\n", events, k);
+  std::int64_t checksum = 0;
+  double multi = Measure([&] {
+    s21::multiset<std::int64_t> top;
+    for (auto v : stream) {
+      if (top.size() < k) {
+        top.insert(v);
+      } else if (*top.begin() < v) {
+        top.erase(top.begin());
+        top.insert(v);
+      }
+    }
+    checksum += *top.begin();
+  });
+  Report("multiset insert + erase(begin)", multi, events);
+  double bounded = Measure([&] {
+    s21::bounded_multiset<std::int64_t> top(k);
+    for (auto v : stream) top.insert(v);
+    checksum -= top.threshold();
+  });
+  Report("bounded_multiset insert", bounded, events);
+  printf("  speedup %.1fx%s\n", multi / bounded,
+         checksum == 0 ? "" : ", THRESHOLD MISMATCH");
+}
+
+void BenchWindowQuantiles() {
+  const std::size_t events = 200000, every = 1000;
+  std::mt19937 gen(45);
+  std::normal_distribution<double> latency(100, 15);
+  printf("window quantiles: %zu samples, median + p99 every %zu samples\n",
+         events, every);
+  for (std::size_t window : {1000, 10000, 100000, 1000000}) {
+    std::vector<double> stream(window + events);
+    for (auto &sample : stream) sample = latency(gen);
+    double naive_sum = 0, ranked_sum = 0;
+    double naive = Measure([&] {
+      s21::multiset<double> samples;
+      for (std::size_t i = 0; i < stream.size(); ++i) {
+        samples.insert(stream[i]);
+        if (i >= window) samples.erase(samples.find(stream[i - window]));
+        if (i >= window && i % every == 0) {
+          std::size_t n = samples.size() - 1;
+          naive_sum += *std::next(samples.begin(), n / 2);
+          naive_sum += *std::next(samples.begin(),
+                                  static_cast<std::size_t>(0.99 * n));
+        }
+      }
+    });
+    double ranked = Measure([&] {
+      s21::window_quantiles<double> samples(window);
+      for (std::size_t i = 0; i < stream.size(); ++i) {
+        samples.push(stream[i]);
+        if (i >= window && i % every == 0) {
+          ranked_sum += samples.quantile(0.5);
+          ranked_sum += samples.quantile(0.99);
+        }
+      }
+    });
+    char label[64];
+    snprintf(label, sizeof(label), "w=%zu multiset + std::next", window);
+    Report(label, naive, stream.size());
+    snprintf(label, sizeof(label), "w=%zu window_quantiles", window);
+    Report(label, ranked, stream.size());
+    printf("  speedup %.1fx%s\n", naive / ranked,
+           naive_sum == ranked_sum ? "" : ", QUANTILE MISMATCH");
+  }
+}
+
+void BenchSharded() {
+  const std::size_t count = 2000000;
+  std::mt19937 gen(46);
+  std::vector<std::string> tokens(count);
+  for (auto &token : tokens) token = "token" + std::to_string(gen() % 50000);
+  printf("sharded: %zu tokens, %u hardware threads\n", count,
+         std::thread::hardware_concurrency());
+  for (unsigned threads : {1u, 2u, 4u}) {
+    auto ingest = [&](auto &&insert) {
+      std::vector<std::thread> workers;
+      for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+          for (std::size_t i = t; i < count; i += threads) insert(t, i);
+        });
+      }
+      for (auto &worker : workers) worker.join();
+    };
+    s21::multiset<std::string> locked;
+    std::mutex mutex;
+    char label[64];
+    snprintf(label, sizeof(label), "%u threads, multiset + mutex", threads);
+    Report(label, Measure([&] {
+             ingest([&](unsigned, std::size_t i) {
+               std::lock_guard<std::mutex> lock(mutex);
+               locked.insert(tokens[i]);
+             });
+           }),
+           count);
+    s21::sharded_multiset<std::string> sharded(threads);
+    snprintf(label, sizeof(label), "%u threads, sharded_multiset", threads);
+    Report(label, Measure([&] {
+             ingest([&](unsigned t, std::size_t i) {
+               sharded.insert(t, tokens[i]);
+             });
+           }),
+           count);
+    snprintf(label, sizeof(label), "%u threads, consolidate", threads);
+    Report(label, Measure([&] { sharded.consolidate(); }), count);
+    if (sharded.count(tokens[0]) != locked.count(tokens[0])) {
+      printf("  COUNT MISMATCH\n");
+    }
+  }
+}
+
+void BenchWriteBuffer() {
+  const std::size_t count = 4000000;
+  std::mt19937_64 gen(47);
+  std::vector<std::int64_t> keys(count);
+  for (auto &k : keys) k = static_cast<std::int64_t>(gen() >> 1);
+  printf("write buffer: burst of %zu random inserts, then one read\n",
+         count);
+  Report("std::sort of the burst", Measure([&] {
+           auto sorted = keys;
+           std::sort(sorted.begin(), sorted.end());
+         }),
+         count);
+  Report("multiset insert", Measure([&] {
+           s21::multiset<std::int64_t> set;
+           for (auto k : keys) set.insert(k);
+         }),
+         count);
+  for (std::size_t buffer : {std::size_t{1} << 12, std::size_t{1} << 16,
+                             std::size_t{1} << 20}) {
+    char label[64];
+    snprintf(label, sizeof(label), "multiset insert_buffered, %zu", buffer);
+    Report(label, Measure([&] {
+             s21::multiset<std::int64_t> set;
+             set.set_write_buffer(buffer);
+             for (auto k : keys) set.insert_buffered(k);
+             if (set.size() != count) printf("  SIZE MISMATCH\n");
+           }),
+           count);
+  }
+
+  // поиски между вставками не сортируют буфер заново
+  const std::size_t pairs = 20000;
+  printf("write buffer: %zu inserts interleaved with contains, set of %zu\n",
+         pairs, count / 4);
+  for (bool buffered : {false, true}) {
+    s21::multiset<std::int64_t> set;
+    for (std::size_t i = 0; i < count / 4; ++i) set.insert(keys[i]);
+    if (buffered) set.set_write_buffer(std::size_t{1} << 12);
+    std::size_t found = 0;
+    Report(buffered ? "insert_buffered + contains" : "insert + contains",
+           Measure([&] {
+             for (std::size_t i = 0; i < pairs; ++i) {
+               std::int64_t key = keys[count - 1 - i];
+               if (buffered) {
+                 set.insert_buffered(key);
+               } else {
+                 set.insert(key);
+               }
+               found += set.contains(key ^ 1);
+             }
+           }),
+           pairs);
+    printf("  found %zu\n", found);
+  }
+}
+
+constexpr std::string_view kKeywordList[] = {
+    "alignas",   "alignof",   "and",       "asm",       "auto",
+    "bool",      "break",     "case",      "catch",     "char",
+    "class",     "const",     "constexpr", "continue",  "decltype",
+    "default",   "delete",    "do",        "double",    "else",
+    "enum",      "explicit",  "export",    "extern",    "false",
+    "float",     "for",       "friend",    "goto",      "if",
+    "inline",    "int",       "long",      "mutable",   "namespace",
+    "new",       "noexcept",  "not",       "nullptr",   "operator",
+    "or",        "private",   "protected", "public",    "register",
+    "return",    "short",     "signed",    "sizeof",    "static",
+    "struct",    "switch",    "template",  "this",      "throw",
+    "true",      "try",       "typedef",   "typeid",    "typename",
+    "union",     "unsigned",  "using",     "virtual",   "void",
+    "volatile",  "while",     "xor",
+};
+
+void BenchStaticSet() {
+  constexpr auto keywords = s21::make_static_set(kKeywordList);
+  const std::size_t builds = 100000, count = 20000000;
+  // токены исходника: примерно треть - ключевые слова
+  std::mt19937 gen(48);
+  std::vector<std::string_view> tokens(1 << 16);
+  const std::string_view idents[] = {"value", "i",   "size", "it",
+                                     "std",   "key", "node", "count"};
+  for (auto &token : tokens) {
+    token = gen() % 3 == 0 ? kKeywordList[gen() % std::size(kKeywordList)]
+                           : idents[gen() % std::size(idents)];
+  }
+  printf("static set: %zu keywords, %zu token lookups\n",
+         std::size(kKeywordList), count);
+  std::size_t sink = 0;
+  Report("set<string_view> construction", Measure([&] {
+           for (std::size_t i = 0; i < builds; ++i) {
+             s21::set<std::string_view> set;
+             for (auto keyword : kKeywordList) set.insert(keyword);
+             sink += set.size();
+           }
+         }),
+         builds);
+  Report("static_set (built at compile time)", Measure([&] {
+           for (std::size_t i = 0; i < builds; ++i) {
+             auto copy = keywords;
+             sink += copy.size();
+           }
+         }),
+         builds);
+  s21::set<std::string_view> set;
+  for (auto keyword : kKeywordList) set.insert(keyword);
+  std::size_t hits[3] = {};
+  Report("set<string_view>::contains", Measure([&] {
+           for (std::size_t i = 0; i < count; ++i) {
+             hits[0] += set.contains(tokens[i & (tokens.size() - 1)]);
+           }
+         }),
+         count);
+  Report("static_set::contains (perfect hash)", Measure([&] {
+           for (std::size_t i = 0; i < count; ++i) {
+             hits[1] += keywords.contains(tokens[i & (tokens.size() - 1)]);
+           }
+         }),
+         count);
+  Report("static_set::lower_bound (Eytzinger)", Measure([&] {
+           for (std::size_t i = 0; i < count; ++i) {
+             std::string_view token = tokens[i & (tokens.size() - 1)];
+             auto it = keywords.lower_bound(token);
+             hits[2] += it != keywords.end() && *it == token;
+           }
+         }),
+         count);
+  if (hits[0] != hits[1] || hits[0] != hits[2] || sink == 0) {
+    printf("  LOOKUP MISMATCH\n");
+  }
+
+  // упорядоченный поиск в большой таблице, где раскладка важнее
+  constexpr std::size_t kTable = 1 << 16;
+  static int raw[kTable];
+  for (auto &key : raw) key = static_cast<int>(gen() >> 1);
+  static s21::static_set<int, kTable> table(raw);
+  s21::set<int> tree;
+  for (int key : raw) tree.insert(key);
+  std::vector<int> sorted(table.begin(), table.end());
+  std::vector<int> probes(1 << 16);
+  for (auto &key : probes) key = static_cast<int>(gen() >> 1);
+  printf("static set: %zu int keys, %zu lower_bound calls\n", kTable, count);
+  std::size_t sums[3] = {};
+  Report("set<int>::lower_bound", Measure([&] {
+           for (std::size_t i = 0; i < count; ++i) {
+             auto it = tree.lower_bound(probes[i & (probes.size() - 1)]);
+             sums[0] += it != tree.end() ? *it & 1 : 0;
+           }
+         }),
+         count);
+  Report("std::lower_bound over sorted array", Measure([&] {
+           for (std::size_t i = 0; i < count; ++i) {
+             auto it = std::lower_bound(sorted.begin(), sorted.end(),
+                                        probes[i & (probes.size() - 1)]);
+             sums[1] += it != sorted.end() ? *it & 1 : 0;
+           }
+         }),
+         count);
+  Report("static_set<int>::lower_bound (Eytzinger)", Measure([&] {
+           for (std::size_t i = 0; i < count; ++i) {
+             auto it = table.lower_bound(probes[i & (probes.size() - 1)]);
+             sums[2] += it != table.end() ? *it & 1 : 0;
+           }
+         }),
+         count);
+  if (sums[0] != sums[1] || sums[0] != sums[2]) printf("  BOUND MISMATCH\n");
+}
+
+void BenchSplitJoin() {
+  const std::size_t count = 1000000, rounds = 1000;
+  s21::set<std::int64_t> set;
+  std::vector<std::int64_t> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  set.assign_sorted(keys.begin(), keys.end());
+  printf("split/join: move the upper half of a %zu-element set\n", count);
+  Report("extract + insert of k/2 elements (one move)", Measure([&] {
+           s21::set<std::int64_t> upper;
+           for (auto it = set.lower_bound(count / 2); it != set.end();) {
+             auto pos = it;
+             ++it;
+             upper.insert(*pos);
+             set.erase(pos);
+           }
+           set.merge(upper);
+         }),
+         1);
+  Report("split + join at random keys", Measure([&] {
+           std::mt19937_64 gen(49);
+           for (std::size_t i = 0; i < rounds; ++i) {
+             auto upper = set.split(static_cast<std::int64_t>(gen() % count));
+             set.join(upper);
+           }
+         }),
+         rounds);
+  if (set.size() != count) printf("  SIZE MISMATCH\n");
+  struct Ranked : s21::TreeOptions {
+    using rank_policy = s21::SubtreeRank;
+  };
+  s21::set<std::int64_t, std::less<std::int64_t>, Ranked> ranked;
+  ranked.assign_sorted(keys.begin(), keys.end());
+  Report("split + join at random keys, SubtreeRank", Measure([&] {
+           std::mt19937_64 gen(49);
+           for (std::size_t i = 0; i < rounds; ++i) {
+             auto upper =
+                 ranked.split(static_cast<std::int64_t>(gen() % count));
+             ranked.join(upper);
+           }
+         }),
+         rounds);
+}
+
+void BenchMappedSet() {
+  // 32M ключей по 32 байта на узел: дерево в файле около 1 ГиБ
+  const std::size_t count = std::size_t{1} << 25, lookups = 1000000;
+  const std::string path = "bench_mapped.bin", dump = "bench_keys.bin";
+  std::remove(path.c_str());
+  std::vector<std::int64_t> keys(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys[i] = static_cast<std::int64_t>(i * 2);
+  }
+  printf("mapped set: %zu keys\n", count);
+  Report("mapped_set build: assign_sorted + sync", Measure([&] {
+           s21::mapped_set<std::int64_t> set(path);
+           set.assign_sorted(keys.begin(), keys.end());
+           set.sync();
+         }),
+         count);
+  {
+    std::ofstream out(dump, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(keys.data()),
+              static_cast<std::streamsize>(count * sizeof(std::int64_t)));
+  }
+  std::vector<std::int64_t>().swap(keys);
+  std::mt19937_64 gen(50);
+  std::vector<std::int64_t> probes(lookups);
+  for (auto &key : probes) key = static_cast<std::int64_t>(gen() % (2 * count));
+  // холодный старт из кэша страниц: чтение и перестройка против mmap
+  std::size_t hits[2] = {};
+  Report("cold start: read keys + set::assign_sorted", Measure([&] {
+           std::ifstream in(dump, std::ios::binary);
+           std::vector<std::int64_t> loaded(count);
+           in.read(reinterpret_cast<char *>(loaded.data()),
+                   static_cast<std::streamsize>(count * sizeof(std::int64_t)));
+           s21::set<std::int64_t> set;
+           set.assign_sorted(loaded.begin(), loaded.end());
+           hits[0] += set.contains(probes[0]);
+         }),
+         1);
+  Report("cold start: mapped_set open + first lookup", Measure([&] {
+           s21::mapped_set<std::int64_t> set(path, true);
+           hits[1] += set.contains(probes[0]);
+         }),
+         1);
+  {
+    std::ifstream in(dump, std::ios::binary);
+    std::vector<std::int64_t> loaded(count);
+    in.read(reinterpret_cast<char *>(loaded.data()),
+            static_cast<std::streamsize>(count * sizeof(std::int64_t)));
+    s21::set<std::int64_t> set;
+    set.assign_sorted(loaded.begin(), loaded.end());
+    Report("set::contains", Measure([&] {
+             for (auto key : probes) hits[0] += set.contains(key);
+           }),
+           lookups);
+  }
+  s21::mapped_set<std::int64_t> mapped(path, true);
+  Report("mapped_set::contains", Measure([&] {
+           for (auto key : probes) hits[1] += mapped.contains(key);
+         }),
+         lookups);
+  if (hits[0] != hits[1]) printf("  LOOKUP MISMATCH\n");
+  std::remove(path.c_str());
+  std::remove(dump.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  struct {
+    const char *name;
+    void (*run)();
+  } benches[] = {
+      {"loader", BenchLoader},
+      {"strings", BenchStrings},
+      {"wordcount", BenchWordCount},
+      {"compare", BenchCompare},
+      {"moves", BenchMoves},
+      {"finger", BenchFinger},
+      {"balance", BenchBalancePolicies},
+      {"lazy", BenchLazyErase},
+      {"fingerprint", BenchFingerprint},
+      {"parallel", BenchParallel},
+      {"views", BenchViews},
+      {"arena", BenchArena},
+      {"radix", BenchRadix},
+      {"bitmap", BenchBitmap},
+      {"bloom", BenchBloom},
+      {"topk", BenchTopK},
+      {"quantiles", BenchWindowQuantiles},
+      {"sharded", BenchSharded},
+      {"buffer", BenchWriteBuffer},
+      {"static", BenchStaticSet},
+      {"split", BenchSplitJoin},
+      {"mapped", BenchMappedSet},
+  };
+  for (const auto &bench : benches) {
+    bool selected = argc == 1;
+    for (int i = 1; i < argc; ++i) {
+      selected = selected || strcmp(argv[i], bench.name) == 0;
+    }
+    if (selected) bench.run();
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+#ifndef S21_ARENA_H_
+#define S21_ARENA_H_
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Арена байтов только на добавление. Строки копируются в большие
+/// блоки, адреса сохранённых байтов не меняются до Clear() или удаления.
+class ByteArena {
+ public:
+  using size_type = std::size_t;
+
+  /// @brief Конструктор по умолчанию.
+  ByteArena() = default;
+
+  ByteArena(const ByteArena &) = delete;
+  ByteArena &operator=(const ByteArena &) = delete;
+
+  /// @brief Конструктор перемещения.
+  ByteArena(ByteArena &&other) noexcept { Swap(other); }
+
+  /// @brief Оператор присваивания перемещением.
+  ByteArena &operator=(ByteArena &&other) noexcept {
+    if (this != &other) {
+      Clear();
+      Swap(other);
+    }
+    return *this;
+  }
+
+  /// @brief Копирует байты в арену.
+  /// @param bytes Сохраняемые байты.
+  /// @return Указатель на копию внутри арены.
+  const char *Store(std::string_view bytes) {
+    used_ += bytes.size();
+    if (bytes.size() > kBlockSize / 4) {
+      // крупная строка получает отдельный блок, текущий блок не теряется
+      char *res = Allocate(bytes.size());
+      std::memcpy(res, bytes.data(), bytes.size());
+      return res;
+    }
+    if (bytes.size() > left_) {
+      cur_ = Allocate(kBlockSize);
+      left_ = kBlockSize;
+    }
+    char *res = cur_;
+    std::memcpy(res, bytes.data(), bytes.size());
+    cur_ += bytes.size();
+    left_ -= bytes.size();
+    return res;
+  }
+
+  /// @brief Освобождает все блоки.
+  void Clear() noexcept {
+    blocks_.clear();
+    cur_ = nullptr;
+    left_ = 0;
+    used_ = 0;
+    capacity_ = 0;
+  }
+
+  /// @brief Обмен содержимым двух арен.
+  void Swap(ByteArena &other) noexcept {
+    std::swap(blocks_, other.blocks_);
+    std::swap(cur_, other.cur_);
+    std::swap(left_, other.left_);
+    std::swap(used_, other.used_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  /// @brief Количество сохранённых байтов.
+  size_type Used() const noexcept { return used_; }
+
+  /// @brief Объём выделенных блоков в байтах.
+  size_type Capacity() const noexcept { return capacity_; }
+
+ private:
+  /// @brief Размер обычного блока.
+  static constexpr size_type kBlockSize = 64 * 1024;
+
+  /// @brief Выделение нового блока.
+  char *Allocate(size_type size) {
+    blocks_.emplace_back(new char[size]);
+    capacity_ += size;
+    return blocks_.back().get();
+  }
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char *cur_ = nullptr;
+  size_type left_ = 0;
+  size_type used_ = 0;
+  size_type capacity_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // S21_ARENA_H_
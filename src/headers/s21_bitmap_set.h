@@ -0,0 +1,593 @@
+#ifndef S21_BITMAP_SET_H_
+#define S21_BITMAP_SET_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_set.h"
+
+namespace s21 {
+
+/// @brief Множество целых чисел в сжатых битовых картах (как в Roaring).
+/// Ключи делятся на блоки по старшим битам, в каждом блоке до 2^16 младших
+/// значений. Разреженный блок хранит упорядоченный массив 16-битных
+/// значений, плотный (больше 4096 значений) - битовую карту из 1024 слов,
+/// по которой обход идёт через ctz, а объединение и пересечение - по словам
+/// (циклы по словам векторизуются компилятором). Размер - от 2 байт на
+/// ключ, плотные диапазоны - 1 бит на ключ. Изменение множества делает
+/// итераторы недействительными, как у вектора.
+template <typename Key>
+class bitmap_set {
+  static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>,
+                "s21::bitmap_set: key must be an integral type");
+
+  struct Chunk;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type;
+  using const_reference = value_type;
+  using key_compare = std::less<Key>;
+  using size_type = std::size_t;
+
+  /// @brief Итератор по возрастанию ключей.
+  class iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Key;
+
+    /// @brief Ключ, на который указывает итератор.
+    Key operator*() const {
+      const Chunk &chunk = set_->chunks_[chunk_];
+      return FromBits(chunk.high, chunk.IsBitmap() ? pos_ : chunk.array[pos_]);
+    }
+
+    iterator &operator++() {
+      const Chunk &chunk = set_->chunks_[chunk_];
+      int next = chunk.IsBitmap() ? NextBit(chunk.words, pos_ + 1)
+                                  : static_cast<int>(pos_ + 1);
+      if (next < 0 || (!chunk.IsBitmap() &&
+                       static_cast<unsigned>(next) == chunk.Count())) {
+        ++chunk_;
+        pos_ = First();
+      } else {
+        pos_ = static_cast<unsigned>(next);
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    iterator &operator--() {
+      int prev = -1;
+      if (chunk_ < set_->chunks_.size() && pos_ > 0) {
+        const Chunk &chunk = set_->chunks_[chunk_];
+        prev = chunk.IsBitmap() ? PrevBit(chunk.words, pos_ - 1)
+                                : static_cast<int>(pos_ - 1);
+      }
+      if (prev < 0) {
+        const Chunk &chunk = set_->chunks_[--chunk_];
+        pos_ = chunk.IsBitmap() ? PrevBit(chunk.words, kChunkSize - 1)
+                                : chunk.Count() - 1;
+      } else {
+        pos_ = static_cast<unsigned>(prev);
+      }
+      return *this;
+    }
+
+    iterator operator--(int) {
+      iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const {
+      return chunk_ == other.chunk_ && pos_ == other.pos_;
+    }
+
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class bitmap_set;
+
+    iterator(const bitmap_set *set, std::size_t chunk, unsigned pos)
+        : set_(set), chunk_(chunk), pos_(pos) {}
+
+    /// @brief Позиция первого ключа блока chunk_ (0 для конца).
+    unsigned First() const {
+      if (chunk_ == set_->chunks_.size()) {
+        return 0;
+      }
+      const Chunk &chunk = set_->chunks_[chunk_];
+      return chunk.IsBitmap() ? NextBit(chunk.words, 0) : 0;
+    }
+
+    const bitmap_set *set_;
+    std::size_t chunk_;
+    /// @brief Индекс в массиве блока или номер бита битовой карты.
+    unsigned pos_;
+  };
+
+  using const_iterator = iterator;
+
+  /// @brief Конструктор по умолчанию.
+  bitmap_set() = default;
+
+  /// @brief Конструктор списка инициализации.
+  /// @param items Список инициализации.
+  bitmap_set(std::initializer_list<value_type> const &items) {
+    for (auto const &item : items) {
+      insert(item);
+    }
+  }
+
+  /// @brief Преобразование из s21::set с теми же ключами: ключи по
+  /// возрастанию добавляются в конец блоков.
+  template <typename Compare, typename Options>
+  explicit bitmap_set(const set<Key, Compare, Options> &other) {
+    for (auto it = other.begin(); it != other.end(); ++it) {
+      insert(*it);
+    }
+  }
+
+  iterator begin() const {
+    iterator it(this, 0, 0);
+    it.pos_ = it.First();
+    return it;
+  }
+
+  iterator end() const { return iterator(this, chunks_.size(), 0); }
+
+  /// @brief Возвращает количество элементов в контейнере.
+  size_type size() const { return size_; }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const { return size_ == 0; }
+
+  /// @brief Максимальное количество элементов, которое может хранить контейнер.
+  size_type max_size() const {
+    if constexpr (sizeof(Key) < sizeof(size_type)) {
+      return size_type(1) << (sizeof(Key) * 8);
+    } else {
+      return std::numeric_limits<size_type>::max();
+    }
+  }
+
+  /// @brief Очищает контейнер.
+  void clear() {
+    chunks_.clear();
+    size_ = 0;
+  }
+
+  /// @brief Вставка элемента в контейнер.
+  /// @return Итератор на элемент и флаг успешности вставки.
+  std::pair<iterator, bool> insert(const value_type &value) {
+    const std::uint64_t bits = ToBits(value);
+    const std::uint64_t high = bits >> 16;
+    const unsigned low = bits & 0xffff;
+    std::size_t index = FindChunk(high);
+    if (index == chunks_.size() || chunks_[index].high != high) {
+      Chunk chunk;
+      chunk.high = high;
+      chunk.array.push_back(static_cast<std::uint16_t>(low));
+      chunks_.insert(chunks_.begin() + index, std::move(chunk));
+      ++size_;
+      return {iterator(this, index, 0), true};
+    }
+    Chunk &chunk = chunks_[index];
+    if (chunk.IsBitmap()) {
+      std::uint64_t &word = chunk.words[low >> 6];
+      std::uint64_t bit = std::uint64_t(1) << (low & 63);
+      bool inserted = (word & bit) == 0;
+      word |= bit;
+      chunk.count += inserted;
+      size_ += inserted;
+      return {iterator(this, index, low), inserted};
+    }
+    auto pos = std::lower_bound(chunk.array.begin(), chunk.array.end(), low);
+    unsigned at = static_cast<unsigned>(pos - chunk.array.begin());
+    if (pos != chunk.array.end() && *pos == low) {
+      return {iterator(this, index, at), false};
+    }
+    chunk.array.insert(pos, static_cast<std::uint16_t>(low));
+    ++size_;
+    if (chunk.Count() > kArrayMax) {
+      chunk.ToBitmap();
+      at = low;
+    }
+    return {iterator(this, index, at), true};
+  }
+
+  /// @brief Удаляет элемент из контейнера по позиции.
+  void erase(iterator pos) {
+    if (pos == end()) {
+      return;
+    }
+    Chunk &chunk = chunks_[pos.chunk_];
+    if (chunk.IsBitmap()) {
+      chunk.words[pos.pos_ >> 6] &= ~(std::uint64_t(1) << (pos.pos_ & 63));
+      --chunk.count;
+    } else {
+      chunk.array.erase(chunk.array.begin() + pos.pos_);
+    }
+    --size_;
+    Normalize(pos.chunk_);
+  }
+
+  /// @brief Обменивает содержимое контейнера с другим контейнером.
+  void swap(bitmap_set &other) noexcept {
+    chunks_.swap(other.chunks_);
+    std::swap(size_, other.size_);
+  }
+
+  /// @brief Переносит из other элементы, которых нет в контейнере: в other
+  /// остаётся пересечение, контейнер становится объединением.
+  void merge(bitmap_set &other) {
+    if (this == &other) {
+      return;
+    }
+    bitmap_set common(other);
+    common.intersect_with(*this);
+    union_with(other);
+    other.swap(common);
+  }
+
+  /// @brief Поиск элемента по значению.
+  /// @return Итератор на элемент или end().
+  iterator find(const key_type &key) const {
+    iterator it = lower_bound(key);
+    return it != end() && *it == key ? it : end();
+  }
+
+  /// @brief Проверяет, содержится ли элемент в контейнере: двоичный поиск
+  /// блока и проверка бита или поиск в массиве блока.
+  bool contains(const key_type &key) const {
+    const std::uint64_t bits = ToBits(key);
+    std::size_t index = FindChunk(bits >> 16);
+    if (index == chunks_.size() || chunks_[index].high != bits >> 16) {
+      return false;
+    }
+    return chunks_[index].Contains(bits & 0xffff);
+  }
+
+  /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
+  iterator lower_bound(const key_type &key) const {
+    const std::uint64_t bits = ToBits(key);
+    std::size_t index = FindChunk(bits >> 16);
+    if (index < chunks_.size() && chunks_[index].high == bits >> 16) {
+      const Chunk &chunk = chunks_[index];
+      const unsigned low = bits & 0xffff;
+      if (chunk.IsBitmap()) {
+        int pos = NextBit(chunk.words, low);
+        if (pos >= 0) {
+          return iterator(this, index, static_cast<unsigned>(pos));
+        }
+      } else {
+        auto pos =
+            std::lower_bound(chunk.array.begin(), chunk.array.end(), low);
+        if (pos != chunk.array.end()) {
+          return iterator(this, index,
+                          static_cast<unsigned>(pos - chunk.array.begin()));
+        }
+      }
+      ++index;
+    }
+    iterator it(this, index, 0);
+    it.pos_ = it.First();
+    return it;
+  }
+
+  /// @brief Возвращает итератор на первый элемент, который больше заданного.
+  iterator upper_bound(const key_type &key) const {
+    iterator it = lower_bound(key);
+    if (it != end() && *it == key) {
+      ++it;
+    }
+    return it;
+  }
+
+  /// @brief Объединение с other на месте.
+  void union_with(const bitmap_set &other) {
+    std::vector<Chunk> res;
+    res.reserve(chunks_.size() + other.chunks_.size());
+    std::size_t i = 0, j = 0;
+    while (i < chunks_.size() || j < other.chunks_.size()) {
+      if (j == other.chunks_.size() ||
+          (i < chunks_.size() && chunks_[i].high < other.chunks_[j].high)) {
+        res.push_back(std::move(chunks_[i++]));
+      } else if (i == chunks_.size() ||
+                 other.chunks_[j].high < chunks_[i].high) {
+        res.push_back(other.chunks_[j++]);
+      } else {
+        res.push_back(std::move(chunks_[i++]));
+        res.back().UnionWith(other.chunks_[j++]);
+      }
+    }
+    Assign(std::move(res));
+  }
+
+  /// @brief Пересечение с other на месте.
+  void intersect_with(const bitmap_set &other) {
+    std::vector<Chunk> res;
+    std::size_t i = 0, j = 0;
+    while (i < chunks_.size() && j < other.chunks_.size()) {
+      if (chunks_[i].high < other.chunks_[j].high) {
+        ++i;
+      } else if (other.chunks_[j].high < chunks_[i].high) {
+        ++j;
+      } else {
+        chunks_[i].IntersectWith(other.chunks_[j++]);
+        if (chunks_[i].Count() > 0) res.push_back(std::move(chunks_[i]));
+        ++i;
+      }
+    }
+    Assign(std::move(res));
+  }
+
+  /// @brief Разность с other на месте.
+  void difference_with(const bitmap_set &other) {
+    std::vector<Chunk> res;
+    res.reserve(chunks_.size());
+    std::size_t j = 0;
+    for (auto &chunk : chunks_) {
+      while (j < other.chunks_.size() && other.chunks_[j].high < chunk.high) {
+        ++j;
+      }
+      if (j < other.chunks_.size() && other.chunks_[j].high == chunk.high) {
+        chunk.DifferenceWith(other.chunks_[j]);
+      }
+      if (chunk.Count() > 0) res.push_back(std::move(chunk));
+    }
+    Assign(std::move(res));
+  }
+
+  bool operator==(const bitmap_set &other) const {
+    return size_ == other.size_ && chunks_ == other.chunks_;
+  }
+
+  bool operator!=(const bitmap_set &other) const { return !(*this == other); }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    // вставка может перестроить блоки, поэтому итераторы ищутся после
+    std::vector<Key> keys = {static_cast<Key>(std::forward<Args>(args))...};
+    std::vector<bool> inserted;
+    inserted.reserve(keys.size());
+    for (Key key : keys) inserted.push_back(insert(key).second);
+    std::vector<std::pair<iterator, bool>> res;
+    res.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      res.emplace_back(find(keys[i]), inserted[i]);
+    }
+    return res;
+  }
+
+ private:
+  using bits_type = std::make_unsigned_t<Key>;
+
+  static constexpr unsigned kChunkSize = 1u << 16;
+  static constexpr unsigned kWords = kChunkSize / 64;
+  /// @brief Больше стольких значений блок хранится битовой картой (4096
+  /// значений массива занимают столько же, сколько битовая карта), меньше
+  /// половины - снова массивом.
+  static constexpr unsigned kArrayMax = 4096;
+
+  /// @brief Блок ключей с общими старшими битами.
+  struct Chunk {
+    std::uint64_t high = 0;
+    /// @brief Упорядоченные младшие 16 бит (разреженный блок).
+    std::vector<std::uint16_t> array;
+    /// @brief Битовая карта (плотный блок), пустая у разреженного.
+    std::vector<std::uint64_t> words;
+    /// @brief Количество значений битовой карты.
+    unsigned count = 0;
+
+    bool IsBitmap() const { return !words.empty(); }
+
+    unsigned Count() const {
+      return IsBitmap() ? count : static_cast<unsigned>(array.size());
+    }
+
+    bool Contains(unsigned low) const {
+      if (IsBitmap()) {
+        return (words[low >> 6] >> (low & 63)) & 1;
+      }
+      return std::binary_search(array.begin(), array.end(), low);
+    }
+
+    void ToBitmap() {
+      words.assign(kWords, 0);
+      for (unsigned low : array) {
+        words[low >> 6] |= std::uint64_t(1) << (low & 63);
+      }
+      count = static_cast<unsigned>(array.size());
+      array.clear();
+      array.shrink_to_fit();
+    }
+
+    void ToArray() {
+      array.clear();
+      array.reserve(count);
+      for (int pos = NextBit(words, 0); pos >= 0;
+           pos = NextBit(words, pos + 1)) {
+        array.push_back(static_cast<std::uint16_t>(pos));
+      }
+      words.clear();
+      words.shrink_to_fit();
+      count = 0;
+    }
+
+    /// @brief Пересчёт количества битовой карты по словам.
+    void Recount() {
+      count = 0;
+      for (std::uint64_t word : words) count += __builtin_popcountll(word);
+    }
+
+    void UnionWith(const Chunk &other) {
+      if (!IsBitmap() && !other.IsBitmap()) {
+        std::vector<std::uint16_t> res;
+        res.reserve(array.size() + other.array.size());
+        std::set_union(array.begin(), array.end(), other.array.begin(),
+                       other.array.end(), std::back_inserter(res));
+        array.swap(res);
+        if (array.size() > kArrayMax) ToBitmap();
+        return;
+      }
+      if (!IsBitmap()) ToBitmap();
+      if (other.IsBitmap()) {
+        std::uint64_t *dst = words.data();
+        const std::uint64_t *src = other.words.data();
+        for (unsigned i = 0; i < kWords; ++i) dst[i] |= src[i];
+      } else {
+        for (unsigned low : other.array) {
+          words[low >> 6] |= std::uint64_t(1) << (low & 63);
+        }
+      }
+      Recount();
+    }
+
+    void IntersectWith(const Chunk &other) {
+      if (IsBitmap() && other.IsBitmap()) {
+        std::uint64_t *dst = words.data();
+        const std::uint64_t *src = other.words.data();
+        for (unsigned i = 0; i < kWords; ++i) dst[i] &= src[i];
+        Recount();
+        if (count <= kArrayMax / 2) ToArray();
+        return;
+      }
+      if (IsBitmap()) ToArray();
+      auto end = std::remove_if(array.begin(), array.end(), [&](unsigned low) {
+        return !other.Contains(low);
+      });
+      array.erase(end, array.end());
+    }
+
+    void DifferenceWith(const Chunk &other) {
+      if (IsBitmap()) {
+        if (other.IsBitmap()) {
+          std::uint64_t *dst = words.data();
+          const std::uint64_t *src = other.words.data();
+          for (unsigned i = 0; i < kWords; ++i) dst[i] &= ~src[i];
+        } else {
+          for (unsigned low : other.array) {
+            words[low >> 6] &= ~(std::uint64_t(1) << (low & 63));
+          }
+        }
+        Recount();
+        if (count <= kArrayMax / 2) ToArray();
+        return;
+      }
+      auto end = std::remove_if(array.begin(), array.end(), [&](unsigned low) {
+        return other.Contains(low);
+      });
+      array.erase(end, array.end());
+    }
+
+    bool operator==(const Chunk &other) const {
+      if (high != other.high || Count() != other.Count()) {
+        return false;
+      }
+      if (IsBitmap() == other.IsBitmap()) {
+        return array == other.array && words == other.words;
+      }
+      const Chunk &bitmap = IsBitmap() ? *this : other;
+      const Chunk &sparse = IsBitmap() ? other : *this;
+      return std::all_of(sparse.array.begin(), sparse.array.end(),
+                         [&](unsigned low) { return bitmap.Contains(low); });
+    }
+  };
+
+  /// @brief Биты ключа в порядке std::less.
+  static std::uint64_t ToBits(Key key) {
+    bits_type bits = static_cast<bits_type>(key);
+    if constexpr (std::is_signed_v<Key>) {
+      bits ^= static_cast<bits_type>(bits_type(1) << (sizeof(Key) * 8 - 1));
+    }
+    return bits;
+  }
+
+  static Key FromBits(std::uint64_t high, unsigned low) {
+    bits_type bits = static_cast<bits_type>((high << 16) | low);
+    if constexpr (std::is_signed_v<Key>) {
+      bits ^= static_cast<bits_type>(bits_type(1) << (sizeof(Key) * 8 - 1));
+    }
+    return static_cast<Key>(bits);
+  }
+
+  /// @brief Первый установленный бит не раньше from или -1.
+  static int NextBit(const std::vector<std::uint64_t> &words, unsigned from) {
+    if (from >= kChunkSize) {
+      return -1;
+    }
+    unsigned w = from >> 6;
+    std::uint64_t word = words[w] & (~std::uint64_t(0) << (from & 63));
+    while (word == 0) {
+      if (++w == kWords) {
+        return -1;
+      }
+      word = words[w];
+    }
+    return static_cast<int>(w * 64 + __builtin_ctzll(word));
+  }
+
+  /// @brief Последний установленный бит не позже from или -1.
+  static int PrevBit(const std::vector<std::uint64_t> &words, unsigned from) {
+    int w = static_cast<int>(from >> 6);
+    std::uint64_t word = words[w] & (~std::uint64_t(0) >> (63 - (from & 63)));
+    while (word == 0) {
+      if (--w < 0) {
+        return -1;
+      }
+      word = words[w];
+    }
+    return w * 64 + 63 - __builtin_clzll(word);
+  }
+
+  /// @brief Индекс первого блока со старшими битами не меньше high.
+  std::size_t FindChunk(std::uint64_t high) const {
+    auto it = std::lower_bound(
+        chunks_.begin(), chunks_.end(), high,
+        [](const Chunk &chunk, std::uint64_t h) { return chunk.high < h; });
+    return static_cast<std::size_t>(it - chunks_.begin());
+  }
+
+  /// @brief Удаление пустого блока или перевод поредевшей битовой карты в
+  /// массив.
+  void Normalize(std::size_t index) {
+    Chunk &chunk = chunks_[index];
+    if (chunk.Count() == 0) {
+      chunks_.erase(chunks_.begin() + index);
+    } else if (chunk.IsBitmap() && chunk.count <= kArrayMax / 2) {
+      chunk.ToArray();
+    }
+  }
+
+  /// @brief Замена блоков с пересчётом размера.
+  void Assign(std::vector<Chunk> &&chunks) {
+    chunks_ = std::move(chunks);
+    size_ = 0;
+    for (const auto &chunk : chunks_) size_ += chunk.Count();
+  }
+
+  std::vector<Chunk> chunks_;
+  size_type size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // S21_BITMAP_SET_H_
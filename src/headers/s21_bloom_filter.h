@@ -0,0 +1,162 @@
+#ifndef S21_BLOOM_FILTER_H_
+#define S21_BLOOM_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Совпадает ли эквивалентность ключей по Compare с их равенством.
+/// Фильтр хэширует ключи, поэтому с компаратором, который считает
+/// эквивалентными разные ключи (например, строки без учёта регистра), он
+/// отсекал бы ключи, которые дерево находит. Для своего компаратора, у
+/// которого эквивалентные ключи равны и одинаково хэшируются, шаблон можно
+/// специализировать.
+template <typename Compare>
+struct EquivalenceIsEquality : std::false_type {};
+
+template <typename T>
+struct EquivalenceIsEquality<std::less<T>> : std::true_type {};
+
+template <typename T>
+struct EquivalenceIsEquality<std::greater<T>> : std::true_type {};
+
+/// @brief Политика без фильтра перед поиском: все функции пустые, поиск
+/// всегда спускается по дереву.
+struct NoFilter {
+  static constexpr bool enabled = false;
+
+  template <typename Key>
+  bool MayContain(const Key &) const noexcept {
+    return true;
+  }
+  template <typename Key>
+  void Add(const Key &) noexcept {}
+  void Remove(std::size_t = 1) noexcept {}
+  bool NeedsRebuild() const noexcept { return false; }
+  void Reset(std::size_t) {}
+  void Clear() noexcept {}
+};
+
+/// @brief Блочный фильтр Блума перед Find и Contains: все биты ключа лежат
+/// в одном блоке размером с линию кэша, поэтому отсутствующий ключ
+/// отсекается одним-двумя обращениями к памяти вместо спуска по дереву.
+/// Удалённые ключи из фильтра не убираются, а только считаются: когда их
+/// становится больше половины добавленных или добавлено больше ключей, чем
+/// рассчитан фильтр, дерево перестраивает его по живым ключам за O(n).
+/// Пустой (не выделенный) фильтр пропускает все ключи, поэтому нехватка
+/// памяти при перестройке не приводит к ложным отказам. Поиск не меняет
+/// фильтр; отсечённые и ложно пропущенные поиски считает политика
+/// статистики дерева (TreeStats).
+/// @tparam BitsPerKey Бит на ключ: 10 дают около 1% ложных срабатываний.
+/// @tparam Hash Шаблон хэш-функции ключа.
+template <unsigned BitsPerKey = 10, template <typename> class Hash = std::hash>
+class BasicBloomFilter {
+  static_assert(BitsPerKey > 0, "s21::BloomFilter: BitsPerKey must be > 0");
+
+ public:
+  static constexpr bool enabled = true;
+
+  /// @brief Может ли ключ быть в дереве. false - ключа точно нет.
+  template <typename Key>
+  bool MayContain(const Key &key) const noexcept {
+    if (blocks_.empty()) {
+      return true;
+    }
+    std::uint64_t hash = Mix(Hash<Key>()(key));
+    const Block &block = blocks_[BlockIndex(hash)];
+    std::uint64_t probe = Mix(hash);
+    std::uint32_t bit = static_cast<std::uint32_t>(probe);
+    std::uint32_t step = static_cast<std::uint32_t>(probe >> 32) | 1;
+    for (unsigned i = 0; i < kProbes; ++i, bit += step) {
+      if (!((block.words[(bit >> 6) & 7] >> (bit & 63)) & 1)) return false;
+    }
+    return true;
+  }
+
+  /// @brief Добавление ключа. В невыделенный фильтр ключ не добавляется,
+  /// но учитывается, и NeedsRebuild() требует перестройки.
+  template <typename Key>
+  void Add(const Key &key) noexcept {
+    ++added_;
+    if (blocks_.empty()) {
+      return;
+    }
+    std::uint64_t hash = Mix(Hash<Key>()(key));
+    Block &block = blocks_[BlockIndex(hash)];
+    std::uint64_t probe = Mix(hash);
+    std::uint32_t bit = static_cast<std::uint32_t>(probe);
+    std::uint32_t step = static_cast<std::uint32_t>(probe >> 32) | 1;
+    for (unsigned i = 0; i < kProbes; ++i, bit += step) {
+      block.words[(bit >> 6) & 7] |= std::uint64_t(1) << (bit & 63);
+    }
+  }
+
+  /// @brief Учёт удалённых ключей (их биты остаются).
+  void Remove(std::size_t count = 1) noexcept { removed_ += count; }
+
+  /// @brief Пора ли перестроить фильтр по живым ключам.
+  bool NeedsRebuild() const noexcept {
+    return added_ > capacity_ ||
+           (removed_ > kMinKeys && removed_ * 2 > added_);
+  }
+
+  /// @brief Пустой фильтр на count ключей с запасом вдвое.
+  void Reset(std::size_t count) {
+    capacity_ = count * 2 > kMinKeys ? count * 2 : kMinKeys;
+    std::size_t blocks =
+        (capacity_ * BitsPerKey + kBlockBits - 1) / kBlockBits;
+    blocks_.assign(blocks, Block());
+    added_ = removed_ = 0;
+  }
+
+  /// @brief Освобождение памяти фильтра: дальше он пропускает все ключи.
+  void Clear() noexcept {
+    blocks_.clear();
+    blocks_.shrink_to_fit();
+    capacity_ = added_ = removed_ = 0;
+  }
+
+ private:
+  /// @brief Блок размером с линию кэша.
+  struct alignas(64) Block {
+    std::uint64_t words[8] = {};
+  };
+
+  static constexpr std::size_t kBlockBits = 512;
+  static constexpr std::size_t kMinKeys = 64;
+  /// @brief Число проверяемых бит: BitsPerKey * ln 2 (оптимум для
+  /// стандартного фильтра), не больше 12.
+  static constexpr unsigned kProbes =
+      BitsPerKey * 69 / 100 < 1    ? 1
+      : BitsPerKey * 69 / 100 > 12 ? 12
+                                   : BitsPerKey * 69 / 100;
+
+  /// @brief Финализатор splitmix64: std::hash целых - тождество.
+  static std::uint64_t Mix(std::uint64_t x) noexcept {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
+  /// @brief Номер блока по старшим битам хэша без деления.
+  std::size_t BlockIndex(std::uint64_t hash) const noexcept {
+    return static_cast<std::size_t>(
+        ((hash >> 32) * static_cast<std::uint64_t>(blocks_.size())) >> 32);
+  }
+
+  std::vector<Block> blocks_;
+  std::size_t capacity_ = 0;
+  std::size_t added_ = 0;
+  std::size_t removed_ = 0;
+};
+
+using BloomFilter = BasicBloomFilter<>;
+
+}  // namespace s21
+
+#endif  // S21_BLOOM_FILTER_H_
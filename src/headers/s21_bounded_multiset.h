@@ -0,0 +1,216 @@
+#ifndef S21_BOUNDED_MULTISET_H_
+#define S21_BOUNDED_MULTISET_H_
+
+#include "s21_rbtree.h"
+
+namespace s21 {
+
+/// @brief Мультимножество, хранящее не более capacity наибольших по Compare
+/// элементов (top-K потока). Итератор на наименьший хранимый элемент
+/// (порог) кэшируется, поэтому элемент не больше порога при заполненном
+/// контейнере отбрасывается за O(1) без спуска по дереву. Элемент больше
+/// порога занимает узел вытесняемого порогового элемента: узел извлекается
+/// и вставляется заново, память не выделяется. Для K наименьших элементов
+/// достаточно Compare = std::greater<Key>.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
+class bounded_multiset {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using tree_type = RBTree<key_type, Compare, Options>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор.
+  /// @param capacity Наибольшее количество хранимых элементов.
+  explicit bounded_multiset(size_type capacity)
+      : tree_(new tree_type()), capacity_(capacity), min_(tree_->End()) {}
+
+  /// @brief Конструктор копирования.
+  bounded_multiset(bounded_multiset const &other)
+      : tree_(new tree_type(*other.tree_)),
+        capacity_(other.capacity_),
+        min_(tree_->Begin()) {}
+
+  /// @brief Конструктор перемещения.
+  bounded_multiset(bounded_multiset &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))),
+        capacity_(other.capacity_),
+        min_(tree_->Begin()) {
+    other.min_ = other.tree_->End();
+  }
+
+  /// @brief Оператор присваивания копированием.
+  bounded_multiset &operator=(const bounded_multiset &other) {
+    if (this != &other) {
+      *tree_ = *other.tree_;
+      capacity_ = other.capacity_;
+      min_ = tree_->Begin();
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  bounded_multiset &operator=(bounded_multiset &&other) noexcept {
+    if (this != &other) {
+      *tree_ = std::move(*other.tree_);
+      capacity_ = other.capacity_;
+      min_ = tree_->Begin();
+      other.min_ = other.tree_->Begin();
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~bounded_multiset() { delete tree_; }
+
+  /// @brief Возвращает итератор на первый (пороговый) элемент.
+  iterator begin() { return min_; }
+
+  /// @brief Возвращает итератор на первый (пороговый) элемент.
+  const_iterator begin() const { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() { return tree_->End(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  const_iterator end() const { return tree_->End(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const { return tree_->Size() == 0; }
+
+  /// @brief Возвращает количество элементов в контейнере.
+  size_type size() const { return tree_->Size(); }
+
+  /// @brief Наибольшее количество хранимых элементов.
+  size_type capacity() const { return capacity_; }
+
+  /// @brief Проверяет, заполнен ли контейнер: дальше элементы вытесняют
+  /// порог.
+  bool full() const { return tree_->Size() >= capacity_; }
+
+  /// @brief Наименьший хранимый элемент. Контейнер не должен быть пустым.
+  const_reference threshold() const { return *min_; }
+
+  /// @brief Очищает контейнер.
+  void clear() {
+    tree_->Clear();
+    min_ = tree_->End();
+  }
+
+  /// @brief Вставляет элемент, если он входит в capacity наибольших.
+  /// @param value Вставляемый элемент.
+  /// @return Итератор на вставленный элемент и true, или end() и false,
+  /// если элемент не больше порога заполненного контейнера.
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return Insert(value);
+  }
+
+  /// @brief Вставляет элемент с перемещением (см. insert).
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return Insert(std::move(value));
+  }
+
+  /// @brief Удаляет элемент из контейнера по итератору.
+  void erase(iterator pos) {
+    if (pos == min_) {
+      ++min_;
+    }
+    tree_->Erase(pos);
+  }
+
+  /// @brief Обменивает содержимое контейнера с другим контейнером.
+  void swap(bounded_multiset &other) noexcept {
+    std::swap(tree_, other.tree_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(min_, other.min_);
+  }
+
+  /// @brief Возвращает количество элементов с заданным значением.
+  size_type count(const key_type &key) const {
+    size_type ret = 0;
+    for (auto it = tree_->Lower_Bound(key);
+         it != tree_->End() && !Compare()(key, *it); ++it) {
+      ++ret;
+    }
+    return ret;
+  }
+
+  /// @brief Поиск элемента по значению.
+  iterator find(const key_type &key) {
+    if (empty() || Compare()(key, *min_)) {
+      return end();
+    }
+    auto low = tree_->Lower_Bound(key);
+    if (low == tree_->End() || Compare()(key, *low)) {
+      return tree_->End();
+    }
+    return low;
+  }
+
+  /// @brief Проверяет, содержит ли контейнер элемент с заданным значением.
+  /// Ключи меньше порога отсекаются без спуска по дереву.
+  bool contains(const key_type &key) const {
+    return !empty() && !Compare()(key, *min_) && tree_->Contains(key);
+  }
+
+  /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
+  iterator lower_bound(const key_type &key) { return tree_->Lower_Bound(key); }
+
+  /// @brief Возвращает итератор на первый элемент, который больше заданного.
+  iterator upper_bound(const key_type &key) { return tree_->Upper_Bound(key); }
+
+  bool operator==(bounded_multiset const &other) const {
+    return *tree_ == *other.tree_;
+  }
+
+  bool operator!=(bounded_multiset const &other) const {
+    return *tree_ != *other.tree_;
+  }
+
+  /// @brief Снимок статистики горячего пути (см. TreeOptions::stats_policy).
+  TreeStatsSnapshot stats() const noexcept { return tree_->Stats(); }
+
+  /// @brief Обнуление статистики.
+  void reset_stats() noexcept { tree_->ResetStats(); }
+
+ private:
+  template <typename V>
+  std::pair<iterator, bool> Insert(V &&value) {
+    if (tree_->Size() < capacity_) {
+      auto res = tree_->InsertKey(std::forward<V>(value), false);
+      if (min_ == tree_->End() || Compare()(*res.first, *min_)) {
+        min_ = res.first;
+      }
+      return res;
+    }
+    if (capacity_ == 0 || !Compare()(*min_, value)) {
+      return {end(), false};
+    }
+    // следующий за порогом становится порогом, если новый элемент не
+    // окажется меньше него; узел порога переиспользуется для нового
+    iterator next = std::next(min_);
+    iterator res = end();
+    try {
+      res = tree_->RecycleNode(min_, std::forward<V>(value));
+    } catch (...) {
+      min_ = next;
+      throw;
+    }
+    min_ = next == end() || Compare()(*res, *next) ? res : next;
+    return {res, true};
+  }
+
+  tree_type *tree_;
+  size_type capacity_;
+  iterator min_;
+};
+
+}  // namespace s21
+
+#endif  // S21_BOUNDED_MULTISET_H_
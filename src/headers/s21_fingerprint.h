@@ -0,0 +1,69 @@
+#ifndef S21_FINGERPRINT_H_
+#define S21_FINGERPRINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace s21 {
+
+/// @brief Политика без отпечатка содержимого: все функции пустые.
+struct NoFingerprint {
+  static constexpr bool enabled = false;
+
+  template <typename Key>
+  void Add(const Key &) noexcept {}
+  template <typename Key>
+  void Remove(const Key &) noexcept {}
+  void Reset() noexcept {}
+  void Merge(const NoFingerprint &) noexcept {}
+  void Subtract(const NoFingerprint &) noexcept {}
+  std::uint64_t Value() const noexcept { return 0; }
+};
+
+/// @brief Отпечаток содержимого, не зависящий от порядка: сумма
+/// перемешанных хэшей ключей по модулю 2^64. Сумма (а не xor) различает
+/// повторы в мультимножестве. Равные деревья всегда имеют равные отпечатки,
+/// разные - почти всегда разные.
+/// @tparam Hash Шаблон хэш-функции ключа.
+template <template <typename> class Hash = std::hash>
+struct BasicHashFingerprint {
+  static constexpr bool enabled = true;
+
+  template <typename Key>
+  void Add(const Key &key) noexcept {
+    value_ += Mix(Hash<Key>()(key));
+  }
+  template <typename Key>
+  void Remove(const Key &key) noexcept {
+    value_ -= Mix(Hash<Key>()(key));
+  }
+  void Reset() noexcept { value_ = 0; }
+  /// @brief Отпечаток объединения с other (без общих элементов).
+  void Merge(const BasicHashFingerprint &other) noexcept {
+    value_ += other.value_;
+  }
+  /// @brief Отпечаток без части other.
+  void Subtract(const BasicHashFingerprint &other) noexcept {
+    value_ -= other.value_;
+  }
+  std::uint64_t Value() const noexcept { return value_; }
+
+ private:
+  /// @brief Финализатор splitmix64: std::hash целых - тождество, а сумма
+  /// тождественных хэшей совпадала бы у {1, 4} и {2, 3}.
+  static std::uint64_t Mix(std::uint64_t x) noexcept {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
+  std::uint64_t value_ = 0;
+};
+
+using HashFingerprint = BasicHashFingerprint<>;
+
+}  // namespace s21
+
+#endif  // S21_FINGERPRINT_H_
@@ -0,0 +1,120 @@
+#ifndef S21_INLINE_STRING_H_
+#define S21_INLINE_STRING_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace s21 {
+
+/// @brief Строковый ключ узла: первые kInline байт хранятся в самом узле,
+/// строки длиннее целиком лежат во внешней арене. Сравнение начинается с
+/// префикса, загруженного машинными словами, и обращается к арене только при
+/// совпадении префиксов у двух длинных строк.
+struct InlineString {
+  using size_type = std::uint32_t;
+
+  /// @brief Размер встроенного префикса.
+  static constexpr size_type kInline = 16;
+
+  /// @brief Конструктор по умолчанию - пустая строка.
+  InlineString() noexcept : head_{}, size_(0), data_(nullptr) {}
+
+  /// @brief Ключ-ссылка на байты строки без копирования.
+  /// @param str Строка. Для длинных строк ключ ссылается на её байты, пока
+  /// они не заменены вызовом Rebind().
+  explicit InlineString(std::string_view str) noexcept
+      : head_{}, size_(static_cast<size_type>(str.size())), data_(nullptr) {
+    std::memcpy(head_, str.data(), IsLong() ? kInline : str.size());
+    if (IsLong()) data_ = str.data();
+  }
+
+  /// @brief Хранится ли часть строки вне узла.
+  bool IsLong() const noexcept { return size_ > kInline; }
+
+  /// @brief Длина строки.
+  size_type Size() const noexcept { return size_; }
+
+  /// @brief Строка целиком.
+  std::string_view View() const noexcept {
+    return {IsLong() ? data_ : head_, size_};
+  }
+
+  /// @brief Перепривязка длинной строки к другой копии тех же байтов.
+  void Rebind(const char *data) noexcept { data_ = data; }
+
+  /// @brief Трёхстороннее сравнение.
+  /// @return Отрицательное число, если a < b, ноль, если равны, иначе
+  /// положительное.
+  static int Compare(const InlineString &a, const InlineString &b) noexcept {
+    for (size_type i = 0; i < kInline; i += sizeof(std::uint64_t)) {
+      std::uint64_t x = Word(a.head_ + i);
+      std::uint64_t y = Word(b.head_ + i);
+      if (x != y) return x < y ? -1 : 1;
+    }
+    // префиксы, дополненные нулями, совпали: если хотя бы одна строка
+    // короткая, она является префиксом другой
+    if (a.IsLong() && b.IsLong()) {
+      size_type len = (a.size_ < b.size_ ? a.size_ : b.size_) - kInline;
+      int res = std::memcmp(a.data_ + kInline, b.data_ + kInline, len);
+      if (res != 0) return res;
+    }
+    return a.size_ < b.size_ ? -1 : (a.size_ > b.size_ ? 1 : 0);
+  }
+
+  bool operator==(const InlineString &other) const noexcept {
+    return Compare(*this, other) == 0;
+  }
+
+  bool operator!=(const InlineString &other) const noexcept {
+    return Compare(*this, other) != 0;
+  }
+
+ private:
+  /// @brief Восемь байт префикса как число, упорядоченное лексикографически.
+  static std::uint64_t Word(const char *bytes) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+  }
+
+  char head_[kInline];
+  size_type size_;
+  const char *data_;
+};
+
+/// @brief Компаратор InlineString.
+struct InlineStringLess {
+  bool operator()(const InlineString &a, const InlineString &b) const noexcept {
+    return InlineString::Compare(a, b) < 0;
+  }
+
+  /// @brief Трёхстороннее сравнение, используется деревом вместо двух
+  /// вызовов operator().
+  int compare(const InlineString &a, const InlineString &b) const noexcept {
+    return InlineString::Compare(a, b);
+  }
+};
+
+/// @brief Ключ InlineString, создаваемый при вставке в дерево: байты длинной
+/// строки копируются в арену при преобразовании, то есть когда
+/// RBTree::TryEmplace действительно создаёт узел, и до того, как узел
+/// подвешен к дереву.
+template <typename Arena>
+struct StoredInlineString {
+  operator InlineString() const {
+    InlineString key(str);
+    if (key.IsLong()) key.Rebind(arena.Store(str));
+    return key;
+  }
+
+  std::string_view str;
+  Arena &arena;
+};
+
+}  // namespace s21
+
+#endif  // S21_INLINE_STRING_H_
@@ -0,0 +1,242 @@
+#ifndef S21_LOADER_H_
+#define S21_LOADER_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "s21_multiset.h"
+#include "s21_set.h"
+
+namespace s21 {
+
+/// @brief Параметры загрузки слов из файла.
+struct LoadOptions {
+  /// @brief Символы-разделители слов (как у strtok).
+  const char *delimiters = " \n\t,.:;!?-()[]{}'\"";
+  /// @brief Количество потоков, 0 - по числу ядер.
+  unsigned threads = 0;
+};
+
+/// @brief Потоковый загрузчик слов: файл отображается в память, делится на
+/// куски, каждый кусок разбивается на слова и сортируется в своём потоке,
+/// после чего отсортированные куски сливаются с подсчётом повторов.
+class WordLoader {
+ public:
+  using size_type = std::size_t;
+  using word_count = std::pair<std::string_view, size_type>;
+
+  /// @brief Открывает файл и разбивает его на отсортированные слова.
+  /// @param path Путь к файлу.
+  /// @param options Параметры загрузки.
+  explicit WordLoader(const std::string &path, LoadOptions options = {}) {
+    Open(path);
+    bool delimiter[256] = {};
+    for (const char *c = options.delimiters; *c; ++c) {
+      delimiter[static_cast<unsigned char>(*c)] = true;
+    }
+    unsigned threads = options.threads;
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+      threads = static_cast<unsigned>(
+          std::min<size_type>(threads, size_ / kMinChunk + 1));
+    }
+    std::vector<std::vector<word_count>> runs(threads);
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; ++i) {
+      workers.emplace_back([&, i] {
+        runs[i] = SortChunk(size_ * i / threads, size_ * (i + 1) / threads,
+                            delimiter);
+      });
+    }
+    runs[0] = SortChunk(0, size_ / threads, delimiter);
+    for (auto &worker : workers) worker.join();
+    counts_ = MergeRuns(std::move(runs));
+  }
+
+  WordLoader(const WordLoader &) = delete;
+  WordLoader &operator=(const WordLoader &) = delete;
+
+  /// @brief Деструктор.
+  ~WordLoader() {
+    if (mapped_) munmap(const_cast<char *>(data_), size_);
+  }
+
+  /// @brief Различные слова в порядке возрастания с числом вхождений.
+  /// Строки ссылаются на отображённый файл и живут, пока жив загрузчик.
+  const std::vector<word_count> &Counts() const noexcept { return counts_; }
+
+  /// @brief Общее количество слов в файле.
+  size_type Total() const noexcept {
+    size_type total = 0;
+    for (const auto &word : counts_) total += word.second;
+    return total;
+  }
+
+ private:
+  /// @brief Минимальный размер куска на поток при автоматическом выборе.
+  static constexpr size_type kMinChunk = 1 << 16;
+
+  /// @brief Отображение файла в память, при неудаче - чтение в буфер.
+  void Open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+          madvise(addr, st.st_size, MADV_SEQUENTIAL);
+          data_ = static_cast<const char *>(addr);
+          size_ = st.st_size;
+          mapped_ = true;
+        }
+      }
+      ::close(fd);
+      if (mapped_) return;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("s21::WordLoader: cannot open " + path);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+  }
+
+  /// @brief Разбивает на слова кусок [begin, end) и сортирует их.
+  /// Куску принадлежат слова, начинающиеся внутри него.
+  std::vector<word_count> SortChunk(size_type begin, size_type end,
+                                    const bool *delimiter) const {
+    auto is_delim = [&](size_type i) {
+      return delimiter[static_cast<unsigned char>(data_[i])];
+    };
+    if (begin > 0) {
+      while (begin < end && !is_delim(begin - 1)) ++begin;
+    }
+    std::vector<std::string_view> words;
+    size_type i = begin;
+    while (i < end) {
+      while (i < end && is_delim(i)) ++i;
+      if (i == end) break;
+      size_type start = i;
+      while (i < size_ && !is_delim(i)) ++i;
+      words.emplace_back(data_ + start, i - start);
+    }
+    std::sort(words.begin(), words.end());
+    std::vector<word_count> run;
+    for (const auto &word : words) {
+      if (!run.empty() && run.back().first == word) {
+        ++run.back().second;
+      } else {
+        run.emplace_back(word, 1);
+      }
+    }
+    return run;
+  }
+
+  /// @brief Слияние двух отсортированных серий с суммированием повторов.
+  static std::vector<word_count> MergeTwo(const std::vector<word_count> &a,
+                                          const std::vector<word_count> &b) {
+    std::vector<word_count> res;
+    res.reserve(a.size() + b.size());
+    auto ia = a.begin(), ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+      if (ia->first < ib->first) {
+        res.push_back(*ia++);
+      } else if (ib->first < ia->first) {
+        res.push_back(*ib++);
+      } else {
+        res.emplace_back(ia->first, ia->second + ib->second);
+        ++ia;
+        ++ib;
+      }
+    }
+    res.insert(res.end(), ia, a.end());
+    res.insert(res.end(), ib, b.end());
+    return res;
+  }
+
+  /// @brief Попарное слияние серий, пары одного раунда сливаются параллельно.
+  static std::vector<word_count> MergeRuns(
+      std::vector<std::vector<word_count>> runs) {
+    while (runs.size() > 1) {
+      std::vector<std::vector<word_count>> next((runs.size() + 1) / 2);
+      std::vector<std::thread> workers;
+      for (size_type i = 0; i + 1 < runs.size(); i += 2) {
+        workers.emplace_back(
+            [&, i] { next[i / 2] = MergeTwo(runs[i], runs[i + 1]); });
+      }
+      if (runs.size() % 2) next.back() = std::move(runs.back());
+      for (auto &worker : workers) worker.join();
+      runs = std::move(next);
+    }
+    return runs.empty() ? std::vector<word_count>() : std::move(runs[0]);
+  }
+
+  const char *data_ = nullptr;
+  size_type size_ = 0;
+  bool mapped_ = false;
+  std::string buffer_;
+  std::vector<word_count> counts_;
+};
+
+/// @brief Загружает различные слова файла в set за O(n) после сортировки.
+/// @param path Путь к файлу.
+/// @param options Параметры загрузки.
+inline set<std::string> load_set(const std::string &path,
+                                 LoadOptions options = {}) {
+  WordLoader loader(path, options);
+  std::vector<std::string_view> words;
+  words.reserve(loader.Counts().size());
+  for (const auto &word : loader.Counts()) words.push_back(word.first);
+  set<std::string> res;
+  res.assign_sorted(words.begin(), words.end());
+  return res;
+}
+
+/// @brief Загружает все слова файла (с повторами) в multiset за O(n) после
+/// сортировки.
+/// @param path Путь к файлу.
+/// @param options Параметры загрузки.
+inline multiset<std::string> load_multiset(const std::string &path,
+                                           LoadOptions options = {}) {
+  WordLoader loader(path, options);
+  std::vector<std::string_view> words;
+  words.reserve(loader.Total());
+  for (const auto &word : loader.Counts()) {
+    words.insert(words.end(), word.second, word.first);
+  }
+  multiset<std::string> res;
+  res.assign_sorted(words.begin(), words.end());
+  return res;
+}
+
+/// @brief Частоты слов файла в порядке возрастания слов.
+/// @param path Путь к файлу.
+/// @param options Параметры загрузки.
+inline std::vector<std::pair<std::string, std::size_t>> load_word_counts(
+    const std::string &path, LoadOptions options = {}) {
+  WordLoader loader(path, options);
+  std::vector<std::pair<std::string, std::size_t>> res;
+  res.reserve(loader.Counts().size());
+  for (const auto &word : loader.Counts()) {
+    res.emplace_back(std::string(word.first), word.second);
+  }
+  return res;
+}
+
+}  // namespace s21
+
+#endif  // S21_LOADER_H_
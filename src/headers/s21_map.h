@@ -0,0 +1,281 @@
+#ifndef S21_MAP_H_
+#define S21_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+
+#include "s21_rbtree.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
+class map {
+  /// @brief Параметры дерева: пара хранится в узле, ключом служит first.
+  struct MapOptions : Options {
+    using key_policy = SelectFirst;
+  };
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using tree_type = RBTree<value_type, Compare, MapOptions>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор по умолчанию.
+  map() : tree_(new tree_type()) {}
+
+  /// @brief Конструктор списка инициализации.
+  /// @param items Список инициализации.
+  map(std::initializer_list<value_type> const &items) : map() {
+    for (auto const &item : items) {
+      tree_->InsertKey(item, true);
+    }
+  }
+
+  /// @brief Конструктор копирования.
+  /// @param other Контейнер, который копируем.
+  map(map const &other) : tree_(new tree_type(*other.tree_)) {}
+
+  /// @brief Конструктор перемещения.
+  map(map &&other) noexcept : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  /// @brief Оператор присваивания копированием.
+  map &operator=(const map &other) {
+    if (this != &other) {
+      *tree_ = *other.tree_;
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  map &operator=(map &&other) noexcept {
+    if (this != &other) {
+      *tree_ = std::move(*other.tree_);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~map() { delete tree_; }
+
+  /// @brief Доступ к значению по ключу с проверкой.
+  /// @throw std::out_of_range, если ключа нет.
+  mapped_type &at(const key_type &key) {
+    iterator it = tree_->Find(key);
+    if (it == tree_->End()) {
+      throw std::out_of_range("s21::map::at: key not found");
+    }
+    return it->second;
+  }
+
+  /// @brief Доступ к значению по ключу с проверкой.
+  /// @throw std::out_of_range, если ключа нет.
+  const mapped_type &at(const key_type &key) const {
+    return const_cast<map *>(this)->at(key);
+  }
+
+  /// @brief Доступ к значению по ключу. Если ключа нет, вставляется значение
+  /// по умолчанию. Ключ ищется один раз.
+  mapped_type &operator[](const key_type &key) {
+    return try_emplace(key).first->second;
+  }
+
+  /// @brief Доступ к значению по ключу с перемещением ключа при вставке.
+  mapped_type &operator[](key_type &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  /// @brief Возвращает итератор на первый элемент.
+  iterator begin() { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на первый элемент.
+  const_iterator begin() const { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() { return tree_->End(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  const_iterator end() const { return tree_->End(); }
+
+  /// @brief Возвращает количество элементов в контейнере.
+  size_type size() const { return tree_->Size(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  /// @return true, если контейнер пустой, иначе false.
+  bool empty() const { return tree_->Size() == 0; }
+
+  /// @brief Максимальное количество элементов, которое может хранить контейнер.
+  size_type max_size() const { return tree_->Max_Size(); }
+
+  /// @brief Очищает контейнер.
+  void clear() { tree_->Clear(); }
+
+  /// @brief Вставка пары, если ключа ещё нет.
+  /// @return Итератор на элемент с этим ключом и флаг успешности вставки.
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_->TryEmplace(value.first, value);
+  }
+
+  /// @brief Вставка пары с перемещением, если ключа ещё нет.
+  /// @return Итератор на элемент с этим ключом и флаг успешности вставки.
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_->TryEmplace(value.first, std::move(value));
+  }
+
+  /// @brief Вставка значения obj по ключу key, если ключа ещё нет.
+  /// @return Итератор на элемент с этим ключом и флаг успешности вставки.
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return tree_->TryEmplace(key, key, obj);
+  }
+
+  /// @brief Вставка или замена значения по ключу за один спуск.
+  /// @return Итератор на элемент и true, если элемент вставлен, false, если
+  /// заменено значение существующего.
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+    auto res = tree_->TryEmplace(key, key, std::forward<M>(obj));
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  }
+
+  /// @brief Вставка пары, создаваемой прямо в узле дерева. Узел выделяется
+  /// до поиска, поэтому при известном ключе лучше try_emplace.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_->Emplace(true, std::forward<Args>(args)...);
+  }
+
+  /// @brief Вставка значения, создаваемого из args, если ключа ещё нет. Если
+  /// ключ есть, ни узел, ни значение не создаются, а args не изменяются.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return tree_->TryEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /// @brief То же, что try_emplace, с перемещением ключа при вставке.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return tree_->TryEmplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /// @brief Удаляет элемент из контейнера по позиции.
+  void erase(iterator pos) { tree_->Erase(pos); }
+
+  /// @brief Удаляет элемент с заданным ключом.
+  /// @return Количество удалённых элементов.
+  size_type erase(const key_type &key) {
+    iterator it = tree_->Find(key);
+    if (it == tree_->End()) {
+      return 0;
+    }
+    tree_->Erase(it);
+    return 1;
+  }
+
+  /// @brief Обменивает содержимое контейнера с другим контейнером.
+  void swap(map &other) { tree_->Swap(*other.tree_); }
+
+  /// @brief Переносит из other элементы с ключами, которых нет в контейнере.
+  void merge(map &other) { tree_->Merge(*other.tree_); }
+
+  /// @brief Поиск элемента по ключу.
+  /// @return Итератор на элемент или end().
+  iterator find(const key_type &key) { return tree_->Find(key); }
+
+  /// @brief Проверяет, есть ли в контейнере элемент с ключом.
+  bool contains(const key_type &key) const { return tree_->Contains(key); }
+
+  /// @brief Возвращает итератор на первый элемент с ключом не меньше key.
+  iterator lower_bound(const key_type &key) { return tree_->Lower_Bound(key); }
+
+  /// @brief Возвращает итератор на первый элемент с ключом больше key.
+  iterator upper_bound(const key_type &key) { return tree_->Upper_Bound(key); }
+
+  bool operator==(const map &other) const {
+    return tree_->operator==(*other.tree_);
+  }
+
+  bool operator!=(const map &other) const {
+    return tree_->operator!=(*other.tree_);
+  }
+
+  /// @brief Поиск упорядоченного пакета ключей (см. set::find_sorted_batch).
+  template <typename InputIt>
+  std::vector<iterator> find_sorted_batch(InputIt first, InputIt last) {
+    return tree_->FindSortedBatch(first, last);
+  }
+
+  /// @brief Проверка наличия упорядоченного пакета ключей.
+  template <typename InputIt>
+  std::vector<bool> contains_sorted_batch(InputIt first, InputIt last) const {
+    return tree_->ContainsSortedBatch(first, last);
+  }
+
+  /// @brief Вставка пакета пар, упорядоченных по ключу.
+  template <typename InputIt>
+  std::vector<std::pair<iterator, bool>> insert_sorted_batch(InputIt first,
+                                                             InputIt last) {
+    return tree_->InsertSortedBatch(first, last, true);
+  }
+
+  /// @brief Заменяет содержимое контейнера парами, упорядоченными по ключу,
+  /// за O(n).
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_->AssignSorted(first, last, true);
+  }
+
+  /// @brief Снимок статистики горячего пути (см. TreeOptions::stats_policy).
+  TreeStatsSnapshot stats() const noexcept { return tree_->Stats(); }
+
+  /// @brief Обнуление статистики.
+  void reset_stats() noexcept { tree_->ResetStats(); }
+
+  /// @brief Отпечаток содержимого для ключей кэша и быстрого operator!= (см.
+  /// TreeOptions::fingerprint_policy).
+  std::uint64_t fingerprint() const noexcept { return tree_->Fingerprint(); }
+
+  /// @brief Разбиение на не более чем k непустых поддиапазонов примерно
+  /// равного размера за O(k), например для параллельной обработки.
+  std::vector<std::pair<iterator, iterator>> split_ranges(size_type k) {
+    return tree_->SplitRanges(k);
+  }
+
+  /// @brief Параллельный вызов func для каждого элемента (см.
+  /// RBTree::ParallelForEach). Контейнер не должен изменяться во время обхода.
+  /// @param threads Количество потоков, 0 - по числу ядер.
+  template <typename Func>
+  void parallel_for_each(Func func, unsigned threads = 0) {
+    tree_->ParallelForEach(func, threads);
+  }
+
+  /// @brief Ленивое удаление (см. set::set_lazy_erase).
+  void set_lazy_erase(double threshold) { tree_->SetLazyErase(threshold); }
+
+  /// @brief Немедленное удаление помеченных элементов.
+  void compact() { tree_->Compact(); }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_->Insert_Many(std::forward<Args>(args)...);
+  }
+
+ private:
+  tree_type *tree_;
+};
+
+}  // namespace s21
+
+#endif  // S21_MAP_H_
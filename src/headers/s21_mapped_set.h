@@ -0,0 +1,634 @@
+#ifndef S21_MAPPED_SET_H_
+#define S21_MAPPED_SET_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/// @brief Множество, красно-чёрное дерево которого живёт прямо в файле,
+/// отображённом в память (MAP_SHARED). Узлы ссылаются друг на друга
+/// смещениями от начала файла, а не указателями, поэтому открытие - это
+/// mmap и проверка заголовка без перестройки и десериализации, а файл
+/// можно одновременно читать из нескольких процессов.
+///
+/// Сохранность при сбоях. В начале файла два слота заголовка по 64 КиБ (на
+/// отдельных страницах при любом размере страницы до 64 КиБ, так что раскладка
+/// файла от него не зависит) с номером версии и контрольной суммой; действующим
+/// считается правильный заголовок с большим номером. Узлы зафиксированного
+/// снимка не меняются: вставка копирует узлы пути (и перекрашиваемых дядей) в
+/// конец файла, а узлы, добавленные после фиксации, меняет на месте. sync()
+/// сбрасывает на диск новые узлы, затем пишет заголовок в другой слот и
+/// сбрасывает его, поэтому после сбоя в любой момент файл открывается на
+/// последнем завершённом sync(), а читатели видят свой снимок целым, пока
+/// писатель работает.
+///
+/// Ограничения: ключ тривиально копируемый и не содержит указателей,
+/// Compare без состояния; писатель один; удаления нет (множество для
+/// чтения), а место скопированных узлов и заменённых assign_sorted и clear
+/// снимков не переиспользуется.
+template <typename Key, typename Compare = std::less<Key>>
+class mapped_set {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "s21::mapped_set: Key must be trivially copyable");
+
+  class ConstIterator;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+  using size_type = size_t;
+
+  /// @brief Открытие файла множества.
+  /// @param path Путь к файлу; если файла нет, создаётся пустое множество
+  /// (кроме режима только для чтения).
+  /// @param read_only Открыть только для чтения (читатель).
+  /// @throw std::system_error при ошибке системного вызова,
+  /// std::runtime_error, если в файле нет правильного заголовка.
+  explicit mapped_set(const std::string &path, bool read_only = false)
+      : read_only_(read_only) {
+    fd_ = ::open(path.c_str(), read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) Fail("open");
+    try {
+      struct stat st;
+      if (fstat(fd_, &st) != 0) Fail("fstat");
+      std::size_t size = static_cast<std::size_t>(st.st_size);
+      if (size == 0 && !read_only) {
+        if (ftruncate(fd_, kInitialSize) != 0) Fail("ftruncate");
+        Map(kInitialSize);
+        sync();
+      } else {
+        if (size >= kDataStart) Map(size);
+        if (!LoadHeader()) {
+          throw std::runtime_error("s21::mapped_set: no valid header");
+        }
+      }
+    } catch (...) {
+      Close();
+      throw;
+    }
+  }
+
+  mapped_set(const mapped_set &) = delete;
+  mapped_set &operator=(const mapped_set &) = delete;
+
+  /// @brief Конструктор перемещения.
+  mapped_set(mapped_set &&other) noexcept { Swap(other); }
+
+  /// @brief Оператор присваивания перемещением.
+  mapped_set &operator=(mapped_set &&other) noexcept {
+    if (this != &other) {
+      Close();
+      Swap(other);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор: незафиксированные изменения фиксируются (ошибки
+  /// sync() при этом игнорируются).
+  ~mapped_set() { Close(); }
+
+  /// @brief Итератор на наименьший элемент.
+  const_iterator begin() const {
+    const_iterator it(this);
+    it.PushLeft(root_);
+    return it;
+  }
+
+  /// @brief Итератор за наибольшим элементом.
+  const_iterator end() const { return const_iterator(this); }
+
+  /// @brief Проверяет, пустое ли множество.
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// @brief Количество элементов.
+  size_type size() const noexcept { return static_cast<size_type>(size_); }
+
+  /// @brief Открыто ли множество только для чтения.
+  bool read_only() const noexcept { return read_only_; }
+
+  /// @brief Проверяет, содержит ли множество ключ.
+  bool contains(const key_type &key) const {
+    for (std::uint64_t node = root_; node != 0;) {
+      const Node *n = At(node);
+      if (Less(key, n->key)) {
+        node = n->left;
+      } else if (Less(n->key, key)) {
+        node = n->right;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Количество элементов, равных key (0 или 1).
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  /// @brief Поиск элемента.
+  /// @return Итератор на элемент или end().
+  const_iterator find(const key_type &key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !Less(key, *it) ? it : end();
+  }
+
+  /// @brief Первый элемент, не меньший key.
+  const_iterator lower_bound(const key_type &key) const {
+    const_iterator it(this);
+    for (std::uint64_t node = root_; node != 0;) {
+      const Node *n = At(node);
+      if (!Less(n->key, key)) {
+        it.Push(node);
+        node = n->left;
+      } else {
+        node = n->right;
+      }
+    }
+    return it;
+  }
+
+  /// @brief Первый элемент, больший key.
+  const_iterator upper_bound(const key_type &key) const {
+    const_iterator it(this);
+    for (std::uint64_t node = root_; node != 0;) {
+      const Node *n = At(node);
+      if (Less(key, n->key)) {
+        it.Push(node);
+        node = n->left;
+      } else {
+        node = n->right;
+      }
+    }
+    return it;
+  }
+
+  /// @brief Вставка элемента. Узлы зафиксированного снимка на пути
+  /// копируются, изменение видно другим процессам после sync().
+  /// @return Итератор на элемент и true, если элемент вставлен.
+  /// @throw std::logic_error, если множество открыто только для чтения.
+  std::pair<iterator, bool> insert(const value_type &value) {
+    CheckWritable("insert");
+    std::uint64_t path[kMaxDepth + 1];
+    bool to_left[kMaxDepth + 1];
+    int depth = 0;
+    for (std::uint64_t node = root_; node != 0; ++depth) {
+      if (depth == kMaxDepth) {
+        throw std::length_error("s21::mapped_set::insert: tree too deep");
+      }
+      const Node *n = At(node);
+      if (Less(value, n->key)) {
+        to_left[depth] = true;
+      } else if (Less(n->key, value)) {
+        to_left[depth] = false;
+      } else {
+        return {lower_bound(value), false};
+      }
+      path[depth] = node;
+      node = to_left[depth] ? n->left : n->right;
+    }
+    // value может лежать в отображении, которое Reserve снимет
+    const Key key = value;
+    // путь, новый узел и дяди, перекрашиваемые при балансировке
+    Reserve((2 * static_cast<std::size_t>(depth) + 1) * sizeof(Node));
+    for (int i = 0; i < depth; ++i) {
+      std::uint64_t node = Writable(path[i]);
+      if (node != path[i]) {
+        path[i] = node;
+        Child(i == 0 ? 0 : path[i - 1], i == 0 || to_left[i - 1]) = node;
+      }
+    }
+    path[depth] = NewNode(key, true);
+    Child(depth == 0 ? 0 : path[depth - 1], depth == 0 || to_left[depth - 1]) =
+        path[depth];
+    InsertFixup(path, depth);
+    ++size_;
+    dirty_ = true;
+    return {lower_bound(key), true};
+  }
+
+  /// @brief Замена содержимого отсортированным диапазоном за O(n): узлы
+  /// пишутся подряд в конец файла в порядке возрастания и связываются в
+  /// сбалансированное дерево. Повторы и элементы не по порядку
+  /// пропускаются.
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    CheckWritable("assign_sorted");
+    std::uint64_t start = used_;
+    std::uint64_t count = 0;
+    for (; first != last; ++first) {
+      // копия: *first может лежать в отображении, которое Reserve снимет
+      const Key key = *first;
+      if (count > 0 && !Less(At(used_ - sizeof(Node))->key, key)) {
+        continue;
+      }
+      Reserve(sizeof(Node));
+      NewNode(key, false);
+      ++count;
+    }
+    int red_depth = 0;
+    for (std::uint64_t n = count; n > 1; n >>= 1) ++red_depth;
+    root_ = BuildSubTree(start, 0, count, 0, red_depth);
+    if (root_ != 0) At(root_)->red = false;
+    size_ = count;
+    dirty_ = true;
+  }
+
+  /// @brief Очистка (место старого снимка не освобождается).
+  void clear() {
+    CheckWritable("clear");
+    root_ = 0;
+    size_ = 0;
+    dirty_ = true;
+  }
+
+  /// @brief Фиксация изменений: новые узлы сбрасываются на диск (msync),
+  /// затем заголовок новой версии пишется в свободный слот и тоже
+  /// сбрасывается.
+  /// @throw std::system_error при ошибке msync.
+  void sync() {
+    if (read_only_ || (!dirty_ && sequence_ != 0)) {
+      return;
+    }
+    SyncRange(committed_, used_);
+    Header header{kMagic, kVersion, kNodeSize, sequence_ + 1,
+                  root_,  size_,    used_,     0};
+    header.checksum = Checksum(header);
+    std::uint64_t slot = (header.sequence % 2) * kHeaderSlot;
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(base_ + slot, &header, sizeof(header));
+    SyncRange(slot, slot + sizeof(header));
+    sequence_ = header.sequence;
+    committed_ = used_;
+    dirty_ = false;
+  }
+
+  /// @brief Переход читателя на последний зафиксированный снимок (файл
+  /// перечитывается, если вырос).
+  /// @return true, если снимок сменился.
+  bool refresh() {
+    if (!read_only_) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0) Fail("fstat");
+    if (static_cast<std::size_t>(st.st_size) > mapped_) {
+      Map(static_cast<std::size_t>(st.st_size));
+    }
+    std::uint64_t sequence = sequence_;
+    LoadHeader();
+    return sequence_ != sequence;
+  }
+
+  /// @brief Номер зафиксированной версии.
+  std::uint64_t version() const noexcept { return sequence_; }
+
+  /// @brief Размер файла в байтах.
+  size_type file_size() const noexcept { return mapped_; }
+
+ private:
+  /// @brief Узел в файле: дети - смещения от начала файла, 0 - нет сына.
+  /// Ссылок на родителя нет, иначе копирование пути задевало бы всё
+  /// дерево.
+  struct Node {
+    std::uint64_t left;
+    std::uint64_t right;
+    Key key;
+    bool red;
+  };
+
+  /// @brief Заголовок версии.
+  struct Header {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t node_size;
+    std::uint64_t sequence;
+    std::uint64_t root;
+    std::uint64_t size;
+    std::uint64_t used;
+    std::uint64_t checksum;
+  };
+
+  static constexpr std::uint64_t kMagic = 0x31746573706d3132ull;
+  static constexpr std::uint32_t kVersion = 2;
+  static constexpr std::uint32_t kNodeSize = sizeof(Node);
+  /// @brief Слот заголовка: не меньше страницы на распространённых
+  /// системах (4, 16 и 64 КиБ).
+  static constexpr std::size_t kHeaderSlot = std::size_t{1} << 16;
+  /// @brief Два слота заголовка, затем узлы.
+  static constexpr std::uint64_t kDataStart = 2 * kHeaderSlot;
+  static constexpr std::size_t kInitialSize = kDataStart + (1 << 16);
+  /// @brief Высота красно-чёрного дерева не больше 2 log2(n + 1).
+  static constexpr int kMaxDepth = 96;
+
+  /// @brief Итератор: стек узлов, от которых спуск шёл влево, вершина -
+  /// текущий узел. Хранит смещения, поэтому переживает перемещение
+  /// отображения при росте файла.
+  class ConstIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    reference operator*() const { return set_->At(stack_[depth_ - 1])->key; }
+    pointer operator->() const { return &**this; }
+
+    ConstIterator &operator++() {
+      std::uint64_t node = stack_[--depth_];
+      PushLeft(set_->At(node)->right);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==(const ConstIterator &other) const {
+      return depth_ == other.depth_ &&
+             (depth_ == 0 || stack_[depth_ - 1] == other.stack_[depth_ - 1]);
+    }
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class mapped_set;
+
+    explicit ConstIterator(const mapped_set *set) : set_(set) {}
+
+    void Push(std::uint64_t node) { stack_[depth_++] = node; }
+
+    void PushLeft(std::uint64_t node) {
+      for (; node != 0; node = set_->At(node)->left) Push(node);
+    }
+
+    const mapped_set *set_;
+    int depth_ = 0;
+    std::uint64_t stack_[kMaxDepth];
+  };
+
+  [[noreturn]] static void Fail(const char *what) {
+    throw std::system_error(errno, std::generic_category(),
+                            std::string("s21::mapped_set: ") + what);
+  }
+
+  void CheckWritable(const char *what) const {
+    if (read_only_) {
+      throw std::logic_error(std::string("s21::mapped_set::") + what +
+                             ": read-only");
+    }
+  }
+
+  static bool Less(const key_type &left, const key_type &right) {
+    return Compare()(left, right);
+  }
+
+  Node *At(std::uint64_t offset) const noexcept {
+    return reinterpret_cast<Node *>(base_ + offset);
+  }
+
+  /// @brief Ссылка на сына parent (0 - ссылка на корень).
+  std::uint64_t &Child(std::uint64_t parent, bool left) {
+    if (parent == 0) return root_;
+    return left ? At(parent)->left : At(parent)->right;
+  }
+
+  static std::uint64_t Checksum(const Header &header) noexcept {
+    std::uint64_t fields[] = {header.magic,    header.version,
+                              header.node_size, header.sequence,
+                              header.root,     header.size,
+                              header.used};
+    std::uint64_t res = 0;
+    for (std::uint64_t field : fields) {
+      res = (res ^ field) * 0x9e3779b97f4a7c15ull;
+      res ^= res >> 29;
+    }
+    return res;
+  }
+
+  /// @brief Загрузка действующего заголовка: правильного, с большим
+  /// номером версии.
+  bool LoadHeader() {
+    if (base_ == nullptr) {
+      return false;
+    }
+    bool found = false;
+    for (std::size_t slot = 0; slot < 2; ++slot) {
+      Header header;
+      std::memcpy(&header, base_ + slot * kHeaderSlot, sizeof(header));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (header.magic != kMagic || header.version != kVersion ||
+          header.node_size != kNodeSize ||
+          header.checksum != Checksum(header) || header.used > mapped_ ||
+          header.used < kDataStart || header.root >= header.used ||
+          (found && header.sequence <= sequence_)) {
+        continue;
+      }
+      found = true;
+      sequence_ = header.sequence;
+      root_ = header.root;
+      size_ = header.size;
+      used_ = committed_ = header.used;
+    }
+    return found;
+  }
+
+  /// @brief Отображение файла размером size (старое снимается после
+  /// успешного mmap).
+  void Map(std::size_t size) {
+    void *addr = mmap(nullptr, size,
+                      read_only_ ? PROT_READ : PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) Fail("mmap");
+    if (base_ != nullptr) munmap(base_, mapped_);
+    base_ = static_cast<char *>(addr);
+    mapped_ = size;
+  }
+
+  /// @brief Размер страницы: msync требует адрес, выровненный по ней.
+  static std::uint64_t PageSize() {
+    static const std::uint64_t page =
+        static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    return page;
+  }
+
+  /// @brief Сброс на диск байтов [from, to) файла: начало выравнивается
+  /// вниз по странице.
+  /// @throw std::system_error при ошибке msync.
+  void SyncRange(std::uint64_t from, std::uint64_t to) {
+    from &= ~(PageSize() - 1);
+    if (to > from && msync(base_ + from, to - from, MS_SYNC) != 0) {
+      Fail("msync");
+    }
+  }
+
+  /// @brief Рост файла вдвое, пока в конце не поместится bytes байт.
+  /// Смещения при этом не меняются, меняется только base_.
+  void Reserve(std::size_t bytes) {
+    if (used_ + bytes <= mapped_) {
+      return;
+    }
+    std::size_t size = mapped_;
+    while (size < used_ + bytes) size *= 2;
+    if (ftruncate(fd_, static_cast<off_t>(size)) != 0) Fail("ftruncate");
+    Map(size);
+  }
+
+  /// @brief Новый узел в конце файла (место зарезервировано).
+  std::uint64_t NewNode(const Key &key, bool red) {
+    std::uint64_t offset = used_;
+    used_ += sizeof(Node);
+    new (At(offset)) Node{0, 0, key, red};
+    return offset;
+  }
+
+  /// @brief Узел, который можно менять: узел зафиксированного снимка
+  /// копируется, новый возвращается как есть.
+  std::uint64_t Writable(std::uint64_t node) {
+    if (node >= committed_) {
+      return node;
+    }
+    const Node copy = *At(node);
+    std::uint64_t offset = used_;
+    used_ += sizeof(Node);
+    new (At(offset)) Node(copy);
+    return offset;
+  }
+
+  /// @brief Поворот: сын node со стороны, противоположной to_left,
+  /// поднимается на место node. Оба узла и parent изменяемые.
+  void Rotate(std::uint64_t node, bool to_left, std::uint64_t parent) {
+    Node *n = At(node);
+    std::uint64_t child = to_left ? n->right : n->left;
+    Node *c = At(child);
+    if (to_left) {
+      n->right = c->left;
+      c->left = node;
+    } else {
+      n->left = c->right;
+      c->right = node;
+    }
+    Child(parent, parent != 0 && At(parent)->left == node) = child;
+  }
+
+  /// @brief Балансировка после вставки по сохранённому пути (ссылок на
+  /// родителя нет). Узлы пути уже изменяемые.
+  /// @param path Путь от корня, path[i] - новый узел.
+  void InsertFixup(std::uint64_t *path, int i) {
+    while (i >= 2 && At(path[i - 1])->red) {
+      std::uint64_t parent = path[i - 1];
+      std::uint64_t grand = path[i - 2];
+      bool parent_left = At(grand)->left == parent;
+      std::uint64_t uncle = parent_left ? At(grand)->right : At(grand)->left;
+      if (uncle != 0 && At(uncle)->red) {  // перекраска, подъём на деда
+        uncle = Writable(uncle);
+        (parent_left ? At(grand)->right : At(grand)->left) = uncle;
+        At(uncle)->red = false;
+        At(parent)->red = false;
+        At(grand)->red = true;
+        i -= 2;
+        continue;
+      }
+      if ((At(parent)->left == path[i]) != parent_left) {  // зигзаг
+        Rotate(parent, parent_left, grand);
+        parent = path[i];
+      }
+      At(parent)->red = false;
+      At(grand)->red = true;
+      Rotate(grand, !parent_left, i >= 3 ? path[i - 3] : 0);
+      break;
+    }
+    At(root_)->red = false;
+  }
+
+  /// @brief Связывание узлов [begin, end), лежащих подряд с start, в
+  /// сбалансированное поддерево: нижний уровень красный.
+  std::uint64_t BuildSubTree(std::uint64_t start, std::uint64_t begin,
+                             std::uint64_t end, int depth, int red_depth) {
+    if (begin == end) {
+      return 0;
+    }
+    std::uint64_t mid = begin + (end - begin) / 2;
+    std::uint64_t node = start + mid * sizeof(Node);
+    std::uint64_t left = BuildSubTree(start, begin, mid, depth + 1, red_depth);
+    std::uint64_t right =
+        BuildSubTree(start, mid + 1, end, depth + 1, red_depth);
+    Node *n = At(node);
+    n->left = left;
+    n->right = right;
+    n->red = depth == red_depth;
+    return node;
+  }
+
+  void Close() noexcept {
+    if (base_ != nullptr && !read_only_ && dirty_) {
+      try {
+        sync();
+      } catch (const std::system_error &) {
+      }
+    }
+    if (base_ != nullptr) munmap(base_, mapped_);
+    if (fd_ >= 0) ::close(fd_);
+    base_ = nullptr;
+    mapped_ = 0;
+    fd_ = -1;
+  }
+
+  void Swap(mapped_set &other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(base_, other.base_);
+    std::swap(mapped_, other.mapped_);
+    std::swap(read_only_, other.read_only_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(used_, other.used_);
+    std::swap(committed_, other.committed_);
+    std::swap(sequence_, other.sequence_);
+    std::swap(dirty_, other.dirty_);
+  }
+
+  int fd_ = -1;
+  char *base_ = nullptr;
+  /// @brief Размер отображения (файла) в байтах.
+  std::size_t mapped_ = 0;
+  bool read_only_ = false;
+  /// @brief Корень рабочей версии (смещение, 0 - пустое дерево).
+  std::uint64_t root_ = 0;
+  std::uint64_t size_ = 0;
+  /// @brief Конец занятой части файла.
+  std::uint64_t used_ = kDataStart;
+  /// @brief Конец зафиксированного снимка: узлы до него не меняются.
+  std::uint64_t committed_ = kDataStart;
+  /// @brief Номер зафиксированной версии.
+  std::uint64_t sequence_ = 0;
+  bool dirty_ = false;
+};
+
+}  // namespace s21
+
+#endif  // S21_MAPPED_SET_H_
@@ -0,0 +1,222 @@
+#ifndef S21_MULTIMAP_H_
+#define S21_MULTIMAP_H_
+
+#include "s21_rbtree.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
+class multimap {
+  /// @brief Параметры дерева: пара хранится в узле, ключом служит first.
+  struct MapOptions : Options {
+    using key_policy = SelectFirst;
+  };
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using tree_type = RBTree<value_type, Compare, MapOptions>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор по умолчанию.
+  multimap() : tree_(new tree_type()) {}
+
+  /// @brief Конструктор списка инициализации.
+  /// @param items Список инициализации.
+  multimap(std::initializer_list<value_type> const &items) : multimap() {
+    for (auto const &item : items) {
+      tree_->InsertKey(item, false);
+    }
+  }
+
+  /// @brief Конструктор копирования.
+  /// @param other Контейнер, который копируем.
+  multimap(multimap const &other) : tree_(new tree_type(*other.tree_)) {}
+
+  /// @brief Конструктор перемещения.
+  multimap(multimap &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  /// @brief Оператор присваивания копированием.
+  multimap &operator=(const multimap &other) {
+    if (this != &other) {
+      *tree_ = *other.tree_;
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  multimap &operator=(multimap &&other) noexcept {
+    if (this != &other) {
+      *tree_ = std::move(*other.tree_);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~multimap() { delete tree_; }
+
+  /// @brief Возвращает итератор на первый элемент.
+  iterator begin() { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на первый элемент.
+  const_iterator begin() const { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() { return tree_->End(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  const_iterator end() const { return tree_->End(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const { return tree_->Size() == 0; }
+
+  /// @brief Возвращает количество элементов в контейнере.
+  size_type size() const { return tree_->Size(); }
+
+  /// @brief Максимальное количество элементов, которое может содержать
+  /// контейнер.
+  size_type max_size() const { return tree_->Max_Size(); }
+
+  /// @brief Очищает контейнер.
+  void clear() { tree_->Clear(); }
+
+  /// @brief Вставляет пару после всех пар с равным ключом.
+  /// @return Итератор на вставленный элемент.
+  iterator insert(const value_type &value) {
+    return tree_->InsertKey(value, false).first;
+  }
+
+  /// @brief Вставляет пару с перемещением.
+  /// @return Итератор на вставленный элемент.
+  iterator insert(value_type &&value) {
+    return tree_->InsertKey(std::move(value), false).first;
+  }
+
+  /// @brief Вставляет пару, создаваемую прямо в узле дерева.
+  /// @return Итератор на вставленный элемент.
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return tree_->Emplace(false, std::forward<Args>(args)...).first;
+  }
+
+  /// @brief Удаляет элемент из контейнера по итератору.
+  void erase(iterator pos) { tree_->Erase(pos); }
+
+  /// @brief Обменивает содержимое контейнера с другим контейнером.
+  void swap(multimap &other) noexcept { tree_->Swap(*other.tree_); }
+
+  /// @brief Сливает other в текущий контейнер.
+  void merge(multimap &other) { tree_->MergeMulti(*other.tree_); }
+
+  /// @brief Возвращает количество элементов с заданным ключом.
+  size_type count(const key_type &key) const {
+    size_type ret = 0;
+    for (auto it = tree_->Lower_Bound(key), up = tree_->Upper_Bound(key);
+         it != up; ++it) {
+      ++ret;
+    }
+    return ret;
+  }
+
+  /// @brief Поиск первого элемента с заданным ключом.
+  /// @return Итератор на найденный элемент или end().
+  iterator find(const key_type &key) {
+    auto low = tree_->Lower_Bound(key);
+    if (low == tree_->End() || Compare()(key, low->first)) {
+      return tree_->End();
+    }
+    return low;
+  }
+
+  /// @brief Проверяет, есть ли в контейнере элемент с ключом.
+  bool contains(const key_type &key) const { return tree_->Contains(key); }
+
+  /// @brief Возвращает итератор на первый элемент с ключом не меньше key.
+  iterator lower_bound(const key_type &key) { return tree_->Lower_Bound(key); }
+
+  /// @brief Возвращает итератор на первый элемент с ключом больше key.
+  iterator upper_bound(const key_type &key) { return tree_->Upper_Bound(key); }
+
+  /// @brief Диапазон элементов с заданным ключом.
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    return {tree_->Lower_Bound(key), tree_->Upper_Bound(key)};
+  }
+
+  bool operator==(multimap const &other) const {
+    return *tree_ == *other.tree_;
+  }
+
+  bool operator!=(multimap const &other) const {
+    return *tree_ != *other.tree_;
+  }
+
+  /// @brief Проверка наличия упорядоченного пакета ключей.
+  template <typename InputIt>
+  std::vector<bool> contains_sorted_batch(InputIt first, InputIt last) const {
+    return tree_->ContainsSortedBatch(first, last);
+  }
+
+  /// @brief Вставка пакета пар, упорядоченных по ключу.
+  template <typename InputIt>
+  std::vector<std::pair<iterator, bool>> insert_sorted_batch(InputIt first,
+                                                             InputIt last) {
+    return tree_->InsertSortedBatch(first, last, false);
+  }
+
+  /// @brief Заменяет содержимое контейнера парами, упорядоченными по ключу,
+  /// за O(n).
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_->AssignSorted(first, last, false);
+  }
+
+  /// @brief Снимок статистики горячего пути (см. TreeOptions::stats_policy).
+  TreeStatsSnapshot stats() const noexcept { return tree_->Stats(); }
+
+  /// @brief Обнуление статистики.
+  void reset_stats() noexcept { tree_->ResetStats(); }
+
+  /// @brief Отпечаток содержимого для ключей кэша и быстрого operator!= (см.
+  /// TreeOptions::fingerprint_policy).
+  std::uint64_t fingerprint() const noexcept { return tree_->Fingerprint(); }
+
+  /// @brief Разбиение на не более чем k непустых поддиапазонов примерно
+  /// равного размера за O(k), например для параллельной обработки.
+  std::vector<std::pair<iterator, iterator>> split_ranges(size_type k) {
+    return tree_->SplitRanges(k);
+  }
+
+  /// @brief Параллельный вызов func для каждого элемента (см.
+  /// RBTree::ParallelForEach). Контейнер не должен изменяться во время обхода.
+  /// @param threads Количество потоков, 0 - по числу ядер.
+  template <typename Func>
+  void parallel_for_each(Func func, unsigned threads = 0) {
+    tree_->ParallelForEach(func, threads);
+  }
+
+  /// @brief Ленивое удаление (см. multiset::set_lazy_erase).
+  void set_lazy_erase(double threshold) { tree_->SetLazyErase(threshold); }
+
+  /// @brief Немедленное удаление помеченных элементов.
+  void compact() { tree_->Compact(); }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_->Insert_Many_Multi(std::forward<Args>(args)...);
+  }
+
+ private:
+  tree_type *tree_;
+};
+
+}  // namespace s21
+
+#endif  // S21_MULTIMAP_H_
@@ -1,20 +1,24 @@
 #ifndef S21_MULTISET_
 #define S21_MULTISET_
 
+#include <stdexcept>
+
 #include "s21_rbtree.h"
 
 namespace s21 {
 
-template <typename Key, typename Compare = std::less<Key>>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
 class multiset {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = RBTree<key_type, Compare>;
-  using iterator = typename RBTree<key_type, Compare>::iterator;
-  using const_iterator = typename RBTree<key_type, Compare>::const_iterator;
+  using key_compare = Compare;
+  using tree_type = RBTree<key_type, Compare, Options>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
 
   /// @brief Конструктор по умолчанию.
@@ -56,10 +60,10 @@ class multiset {
   ~multiset() { delete tree_; }
 
   /// @brief Возвращает итератор на первый элемент.
-  iterator begin() { return tree_->Begin(); }
+  iterator begin() { return Tree()->Begin(); }
 
   /// @brief Возвращает итератор на первый элемент.
-  const_iterator begin() const { return tree_->Begin(); }
+  const_iterator begin() const { return Tree()->Begin(); }
 
   /// @brief Возвращает итератор на элемент, следующий за последним.
   iterator end() { return tree_->End(); }
@@ -68,10 +72,10 @@ class multiset {
   const_iterator end() const { return tree_->End(); }
 
   /// @brief Проверяет, пустой ли контейнер.
-  bool empty() const { return tree_->Size() == 0; }
+  bool empty() const { return Tree()->Size() == 0; }
 
   /// @brief Возвращает количество элементов в контейнере.
-  size_type size() const { return tree_->Size(); }
+  size_type size() const { return Tree()->Size(); }
 
   /// @brief Максимальное количество элементов, которое может содержать
   /// контейнер.
@@ -84,7 +88,22 @@ class multiset {
   /// @param value Вставляемый элемент.
   /// @return Итератор на вставленный элемент.
   iterator insert(const value_type &value) {
-    return tree_->InsertKey(value, false).first;
+    return Tree()->InsertKey(value, false).first;
+  }
+
+  /// @brief Вставляет элемент в контейнер с перемещением.
+  /// @param value Перемещаемый элемент.
+  /// @return Итератор на вставленный элемент.
+  iterator insert(value_type &&value) {
+    return Tree()->InsertKey(std::move(value), false).first;
+  }
+
+  /// @brief Вставляет элемент, создаваемый прямо в узле дерева.
+  /// @param args Аргументы конструктора элемента.
+  /// @return Итератор на вставленный элемент.
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return Tree()->Emplace(false, std::forward<Args>(args)...).first;
   }
 
   /// @brief Удаляет элемент из контейнера по итератору.
@@ -94,11 +113,39 @@ class multiset {
   void swap(multiset &other) noexcept { tree_->Swap(*other.tree_); }
 
   /// @brief Сливает other в текущий контейнер.
-  void merge(multiset &other) { tree_->MergeMulti(*other.tree_); }
+  void merge(multiset &other) { Tree()->MergeMulti(*other.Tree()); }
+
+  /// @brief Сливает other в текущий контейнер за O(n + m) пересборкой
+  /// дерева (см. RBTree::MergeLinear).
+  void merge_linear(multiset &other) { Tree()->MergeLinear(*other.Tree()); }
+
+  /// @brief Разбиение по ключу без выделения памяти под узлы (см.
+  /// RBTree::Split): в контейнере остаются элементы меньше key. Дерево
+  /// режется за O(log n), но размер частей считается обходом меньшей из
+  /// них за O(min(k, n - k)), если в Options нет SubtreeRank, и всегда при
+  /// HashFingerprint: для частых разбиений нужен rank_policy = SubtreeRank.
+  /// Фильтр не перестраивается (у результата его нет до первой вставки).
+  /// @return Контейнер с элементами не меньше key.
+  multiset split(const key_type &key) {
+    multiset res;
+    tree_->Split(key, *res.tree_);
+    return res;
+  }
+
+  /// @brief Присоединение контейнера, все элементы которого не меньше
+  /// элементов текущего, за O(log n) без выделения памяти (см.
+  /// RBTree::Join). other становится пустым. Фильтр не перестраивается
+  /// сразу, а строится заново при следующей вставке.
+  /// @throw std::invalid_argument, если диапазоны элементов пересекаются.
+  void join(multiset &other) {
+    if (!tree_->Join(*other.tree_, false)) {
+      throw std::invalid_argument("s21::multiset::join: ranges overlap");
+    }
+  }
 
   /// @brief Возвращает количество элементов с заданным значением.
   size_type count(const key_type &key) const {
-    auto low = tree_->Lower_Bound(key);
+    auto low = Tree()->Lower_Bound(key);
     if (low == tree_->End() || *low != key) {
       return 0;
     }
@@ -115,7 +162,7 @@ class multiset {
   /// @param key Искомое значение.
   /// @return Итератор на найденный элемент.
   iterator find(const key_type &key) {
-    auto low = tree_->Lower_Bound(key);
+    auto low = Tree()->Lower_Bound(key);
     if (low == tree_->End() || *low != key) {
       return tree_->End();
     }
@@ -127,27 +174,129 @@ class multiset {
   bool contains(const key_type &key) const { return tree_->Contains(key); }
 
   /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
-  iterator lower_bound(const key_type &key) { return tree_->Lower_Bound(key); }
+  iterator lower_bound(const key_type &key) { return Tree()->Lower_Bound(key); }
 
   /// @brief Возвращает итератор на первый элемент, который больше заданного.
-  iterator upper_bound(const key_type &key) { return tree_->Upper_Bound(key); }
+  iterator upper_bound(const key_type &key) { return Tree()->Upper_Bound(key); }
 
   bool operator==(multiset const &other) const {
-    return *tree_ == *other.tree_;
+    return *Tree() == *other.Tree();
   }
 
   bool operator!=(multiset const &other) const {
-    return *tree_ != *other.tree_;
+    return *Tree() != *other.Tree();
+  }
+
+  /// @brief k-й по порядку элемент (с нуля) за O(log n). Требует
+  /// TreeOptions::rank_policy = SubtreeRank.
+  /// @return Итератор на элемент или end(), если k >= size().
+  iterator nth(size_type k) { return Tree()->Select(k); }
+
+  /// @brief Количество элементов меньше key за O(log n). Требует
+  /// TreeOptions::rank_policy = SubtreeRank.
+  size_type rank(const key_type &key) const { return Tree()->Rank(key); }
+
+  /// @brief Проверка наличия упорядоченного пакета ключей.
+  /// @param first Начало диапазона ключей, упорядоченных по Compare.
+  /// @param last Конец диапазона.
+  /// @return Для каждого ключа true, если он есть в контейнере.
+  template <typename InputIt>
+  std::vector<bool> contains_sorted_batch(InputIt first, InputIt last) const {
+    return Tree()->ContainsSortedBatch(first, last);
+  }
+
+  /// @brief Вставка упорядоченного пакета элементов: место каждого ищется от
+  /// предыдущего вставленного.
+  /// @param first Начало диапазона, упорядоченного по Compare.
+  /// @param last Конец диапазона.
+  template <typename InputIt>
+  std::vector<std::pair<iterator, bool>> insert_sorted_batch(InputIt first,
+                                                             InputIt last) {
+    return Tree()->InsertSortedBatch(first, last, false);
+  }
+
+  /// @brief Заменяет содержимое контейнера отсортированным диапазоном за O(n).
+  /// @param first Начало диапазона, упорядоченного по Compare.
+  /// @param last Конец диапазона.
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_->AssignSorted(first, last, false);
   }
 
+  /// @brief Снимок статистики горячего пути (см. TreeOptions::stats_policy).
+  TreeStatsSnapshot stats() const noexcept { return tree_->Stats(); }
+
+  /// @brief Обнуление статистики.
+  void reset_stats() noexcept { tree_->ResetStats(); }
+
+  /// @brief Отпечаток содержимого для ключей кэша и быстрого operator!= (см.
+  /// TreeOptions::fingerprint_policy).
+  std::uint64_t fingerprint() const { return Tree()->Fingerprint(); }
+
+  /// @brief Разбиение на не более чем k непустых поддиапазонов примерно
+  /// равного размера за O(k), например для параллельной обработки.
+  std::vector<std::pair<iterator, iterator>> split_ranges(size_type k) {
+    return Tree()->SplitRanges(k);
+  }
+
+  /// @brief Параллельный вызов func для каждого элемента (см.
+  /// RBTree::ParallelForEach). Контейнер не должен изменяться во время обхода.
+  /// @param threads Количество потоков, 0 - по числу ядер.
+  template <typename Func>
+  void parallel_for_each(Func func, unsigned threads = 0) {
+    Tree()->ParallelForEach(func, threads);
+  }
+
+  /// @brief Ленивое удаление: erase только помечает элемент, а дерево
+  /// перестраивается за O(n), когда доля помеченных превышает порог.
+  /// @param threshold Порог из (0, 1], 0 - обычное удаление.
+  void set_lazy_erase(double threshold) { tree_->SetLazyErase(threshold); }
+
+  /// @brief Немедленное удаление помеченных элементов.
+  void compact() { tree_->Compact(); }
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
-    return tree_->Insert_Many_Multi(std::forward<Args>(args)...);
+    return Tree()->Insert_Many_Multi(std::forward<Args>(args)...);
   }
 
-  void print() { tree_->PrintTree(); }
+  /// @brief Включение буфера записи для пакетов вставок (см.
+  /// RBTree::SetWriteBuffer): insert_buffered не спускается по дереву, а
+  /// буфер вливается одним проходом, когда заполнен или перед чтением.
+  /// Чтения, в том числе константные (size, empty, begin, fingerprint,
+  /// contains_sorted_batch), вливают непустой буфер, то есть меняют
+  /// дерево: перед чтением из нескольких потоков нужно вызвать flush().
+  /// После этого константные члены ничего не пишут.
+  /// @param capacity Размер буфера, 0 - выключить.
+  void set_write_buffer(size_type capacity) {
+    tree_->SetWriteBuffer(capacity);
+  }
+
+  /// @brief Вставка через буфер записи. Итератор не возвращается: элемент
+  /// попадает в дерево при вливании.
+  void insert_buffered(const value_type &value) {
+    tree_->InsertBuffered(value, false);
+  }
+
+  /// @brief Вставка через буфер записи с перемещением.
+  void insert_buffered(value_type &&value) {
+    tree_->InsertBuffered(std::move(value), false);
+  }
+
+  /// @brief Немедленное вливание буфера записи.
+  void flush() { tree_->Flush(); }
+
+  void print() { Tree()->PrintTree(); }
 
  private:
+  /// @brief Дерево с влитым буфером записи: все операции, кроме вставок
+  /// через буфер и contains, видят вставленные через буфер элементы.
+  /// Вливание меняет дерево и в константных членах (см. set_write_buffer).
+  tree_type *Tree() const {
+    tree_->Flush();
+    return tree_;
+  }
+
   tree_type *tree_;
 };
 
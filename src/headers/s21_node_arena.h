@@ -0,0 +1,145 @@
+#ifndef S21_NODE_ARENA_H_
+#define S21_NODE_ARENA_H_
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Политика размещения узлов по умолчанию: каждый узел выделяется в
+/// куче отдельно, узлы можно передавать между деревьями.
+struct HeapNodes {
+  /// @brief Узлы разных деревьев взаимозаменяемы (Merge переносит узлы).
+  static constexpr bool kShared = true;
+
+  void *Allocate(std::size_t size) { return ::operator new(size); }
+  void Deallocate(void *ptr, std::size_t) noexcept { ::operator delete(ptr); }
+  void Release() noexcept {}
+};
+
+/// @brief Арена узлов на больших страницах. Память берётся у mmap кусками,
+/// выровненными на 2 МиБ, с советом MADV_HUGEPAGE (Linux), поэтому узлы,
+/// выделенные подряд, лежат рядом, а спуск по дереву затрагивает меньше
+/// страниц и промахов TLB. Освобождённые узлы переиспользуются через список
+/// свободных, вся память возвращается разом в Release (Clear и деструктор
+/// дерева). Узлы принадлежат арене своего дерева, поэтому Merge копирует
+/// элементы в новые узлы.
+class HugePageArena {
+ public:
+  static constexpr bool kShared = false;
+
+  HugePageArena() = default;
+  HugePageArena(const HugePageArena &) = delete;
+  HugePageArena &operator=(const HugePageArena &) = delete;
+
+  HugePageArena(HugePageArena &&other) noexcept { Swap(other); }
+
+  HugePageArena &operator=(HugePageArena &&other) noexcept {
+    if (this != &other) {
+      Release();
+      Swap(other);
+    }
+    return *this;
+  }
+
+  ~HugePageArena() { Release(); }
+
+  /// @brief Выделение size байт (все узлы дерева одного размера).
+  void *Allocate(std::size_t size) {
+    if (free_ != nullptr) {
+      FreeNode *node = free_;
+      free_ = node->next;
+      return node;
+    }
+    size = (size + kAlign - 1) & ~(kAlign - 1);
+    if (static_cast<std::size_t>(end_ - next_) < size) Grow(size);
+    void *res = next_;
+    next_ += size;
+    return res;
+  }
+
+  /// @brief Возврат узла в список свободных.
+  void Deallocate(void *ptr, std::size_t) noexcept {
+    FreeNode *node = static_cast<FreeNode *>(ptr);
+    node->next = free_;
+    free_ = node;
+  }
+
+  /// @brief Возврат всей памяти системе. Узлы к этому моменту должны быть
+  /// разрушены.
+  void Release() noexcept {
+    for (const auto &chunk : chunks_) munmap(chunk.first, chunk.second);
+    chunks_.clear();
+    next_ = end_ = nullptr;
+    free_ = nullptr;
+    next_chunk_ = kMinChunk;
+  }
+
+  void Swap(HugePageArena &other) noexcept {
+    std::swap(chunks_, other.chunks_);
+    std::swap(next_, other.next_);
+    std::swap(end_, other.end_);
+    std::swap(free_, other.free_);
+    std::swap(next_chunk_, other.next_chunk_);
+  }
+
+  /// @brief Память, полученная у системы, в байтах.
+  std::size_t Capacity() const noexcept {
+    std::size_t res = 0;
+    for (const auto &chunk : chunks_) res += chunk.second;
+    return res;
+  }
+
+ private:
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  static constexpr std::size_t kAlign = alignof(std::max_align_t);
+  static constexpr std::size_t kHugePage = std::size_t{2} << 20;
+  static constexpr std::size_t kMinChunk = kHugePage;
+  static constexpr std::size_t kMaxChunk = std::size_t{64} << 20;
+
+  /// @brief Новый кусок: размер удваивается от 2 до 64 МиБ, чтобы маленькие
+  /// деревья не занимали много памяти, а большие делали мало mmap.
+  void Grow(std::size_t size) {
+    std::size_t chunk = next_chunk_;
+    while (chunk < size) chunk *= 2;
+    // берём на большую страницу больше и обрезаем края, чтобы кусок был
+    // выровнен на 2 МиБ и ядро могло отдать его большими страницами
+    chunks_.reserve(chunks_.size() + 1);
+    std::size_t mapped = chunk + kHugePage;
+    void *addr = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) throw std::bad_alloc();
+    char *raw = static_cast<char *>(addr);
+    char *aligned = reinterpret_cast<char *>(
+        (reinterpret_cast<std::uintptr_t>(raw) + kHugePage - 1) &
+        ~(kHugePage - 1));
+    if (aligned != raw) munmap(raw, aligned - raw);
+    char *tail = aligned + chunk;
+    if (tail != raw + mapped) munmap(tail, raw + mapped - tail);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, chunk, MADV_HUGEPAGE);
+#endif
+    chunks_.emplace_back(aligned, chunk);
+    next_ = aligned;
+    end_ = aligned + chunk;
+    if (next_chunk_ < kMaxChunk) next_chunk_ *= 2;
+  }
+
+  std::vector<std::pair<char *, std::size_t>> chunks_;
+  char *next_ = nullptr;
+  char *end_ = nullptr;
+  FreeNode *free_ = nullptr;
+  std::size_t next_chunk_ = kMinChunk;
+};
+
+}  // namespace s21
+
+#endif  // S21_NODE_ARENA_H_
@@ -0,0 +1,157 @@
+#ifndef S21_RADIX_MULTISET_H_
+#define S21_RADIX_MULTISET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#include "s21_multiset.h"
+#include "s21_radix_set.h"
+
+namespace s21 {
+
+/// @brief Мультимножество целочисленных ключей на адаптивном radix-дереве
+/// (см. radix_set). Повторы ключа хранятся счётчиком в одном листе, поэтому
+/// count() - O(ширины ключа), а не O(log n + count).
+template <typename Key>
+class radix_multiset {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using key_compare = std::less<Key>;
+  using tree_type = RadixTree<key_type>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор по умолчанию.
+  radix_multiset() : tree_(new tree_type()) {}
+
+  /// @brief Конструктор списка инициализации.
+  /// @param items Список инициализации.
+  radix_multiset(std::initializer_list<value_type> const &items)
+      : radix_multiset() {
+    for (auto const &item : items) {
+      tree_->InsertKey(item, false);
+    }
+  }
+
+  /// @brief Конструктор копирования.
+  radix_multiset(radix_multiset const &other)
+      : tree_(new tree_type(*other.tree_)) {}
+
+  /// @brief Конструктор перемещения.
+  radix_multiset(radix_multiset &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  /// @brief Оператор присваивания копированием.
+  radix_multiset &operator=(const radix_multiset &other) {
+    if (this != &other) {
+      *tree_ = *other.tree_;
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  radix_multiset &operator=(radix_multiset &&other) noexcept {
+    if (this != &other) {
+      *tree_ = std::move(*other.tree_);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~radix_multiset() { delete tree_; }
+
+  /// @brief Возвращает итератор на первый элемент.
+  iterator begin() const { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() const { return tree_->End(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const { return tree_->Size() == 0; }
+
+  /// @brief Возвращает количество элементов в контейнере.
+  size_type size() const { return tree_->Size(); }
+
+  /// @brief Максимальное количество элементов, которое может содержать
+  /// контейнер.
+  size_type max_size() const { return tree_->Max_Size(); }
+
+  /// @brief Очищает контейнер.
+  void clear() { tree_->Clear(); }
+
+  /// @brief Вставка элемента после всех равных ему.
+  /// @return Итератор на вставленный элемент.
+  iterator insert(const value_type &value) {
+    return tree_->InsertKey(value, false).first;
+  }
+
+  /// @brief Удаляет один элемент из контейнера по позиции.
+  void erase(iterator pos) { tree_->Erase(pos); }
+
+  /// @brief Обменивает содержимое контейнера с другим контейнером.
+  void swap(radix_multiset &other) noexcept { tree_->Swap(*other.tree_); }
+
+  /// @brief Переносит все элементы other в контейнер.
+  void merge(radix_multiset &other) { tree_->Merge(*other.tree_, false); }
+
+  /// @brief Возвращает количество элементов с заданным ключом.
+  size_type count(const key_type &key) const { return tree_->Count(key); }
+
+  /// @brief Поиск первого элемента с заданным ключом.
+  /// @return Итератор на найденный элемент или end().
+  iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  /// @brief Проверяет, есть ли в контейнере элемент с ключом.
+  bool contains(const key_type &key) const { return tree_->Contains(key); }
+
+  /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
+  iterator lower_bound(const key_type &key) const {
+    return tree_->Lower_Bound(key);
+  }
+
+  /// @brief Возвращает итератор на первый элемент, который больше заданного.
+  iterator upper_bound(const key_type &key) const {
+    return tree_->Upper_Bound(key);
+  }
+
+  /// @brief Диапазон элементов с заданным ключом.
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return {tree_->Lower_Bound(key), tree_->Upper_Bound(key)};
+  }
+
+  bool operator==(const radix_multiset &other) const {
+    return *tree_ == *other.tree_;
+  }
+
+  bool operator!=(const radix_multiset &other) const {
+    return *tree_ != *other.tree_;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> res;
+    res.reserve(sizeof...(Args));
+    (res.push_back({insert(std::forward<Args>(args)), true}), ...);
+    return res;
+  }
+
+ private:
+  tree_type *tree_;
+};
+
+/// @brief Упорядоченное мультимножество с автоматическим выбором движка:
+/// radix_multiset для целочисленных ключей с std::less, иначе multiset.
+template <typename Key, typename Compare = std::less<Key>>
+using ordered_multiset =
+    std::conditional_t<kRadixKey<Key, Compare>, radix_multiset<Key>,
+                       multiset<Key, Compare>>;
+
+}  // namespace s21
+
+#endif  // S21_RADIX_MULTISET_H_
@@ -0,0 +1,155 @@
+#ifndef S21_RADIX_SET_H_
+#define S21_RADIX_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#include "s21_radix_tree.h"
+#include "s21_set.h"
+
+namespace s21 {
+
+/// @brief Множество целочисленных ключей на адаптивном radix-дереве (см.
+/// RadixTree). Порядок и интерфейс как у set с std::less, но поиск и
+/// вставка не сравнивают ключи, а спускаются по их байтам. Элементы
+/// неизменяемы, итераторы остаются действительными при изменении других
+/// элементов.
+template <typename Key>
+class radix_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using key_compare = std::less<Key>;
+  using tree_type = RadixTree<key_type>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор по умолчанию.
+  radix_set() : tree_(new tree_type()) {}
+
+  /// @brief Конструктор списка инициализации.
+  /// @param items Список инициализации.
+  radix_set(std::initializer_list<value_type> const &items) : radix_set() {
+    for (auto const &item : items) {
+      tree_->InsertKey(item, true);
+    }
+  }
+
+  /// @brief Конструктор копирования.
+  radix_set(radix_set const &other) : tree_(new tree_type(*other.tree_)) {}
+
+  /// @brief Конструктор перемещения.
+  radix_set(radix_set &&other) noexcept
+      : tree_(new tree_type(std::move(*other.tree_))) {}
+
+  /// @brief Оператор присваивания копированием.
+  radix_set &operator=(const radix_set &other) {
+    if (this != &other) {
+      *tree_ = *other.tree_;
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  radix_set &operator=(radix_set &&other) noexcept {
+    if (this != &other) {
+      *tree_ = std::move(*other.tree_);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~radix_set() { delete tree_; }
+
+  /// @brief Возвращает итератор на первый элемент.
+  iterator begin() const { return tree_->Begin(); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() const { return tree_->End(); }
+
+  /// @brief Возвращает количество элементов в контейнере.
+  size_type size() const { return tree_->Size(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const { return tree_->Size() == 0; }
+
+  /// @brief Максимальное количество элементов, которое может хранить контейнер.
+  size_type max_size() const { return tree_->Max_Size(); }
+
+  /// @brief Очищает контейнер.
+  void clear() { tree_->Clear(); }
+
+  /// @brief Вставка элемента в контейнер.
+  /// @return Итератор на элемент и флаг успешности вставки.
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_->InsertKey(value, true);
+  }
+
+  /// @brief Удаляет элемент из контейнера по позиции.
+  void erase(iterator pos) { tree_->Erase(pos); }
+
+  /// @brief Обменивает содержимое контейнера с другим контейнером.
+  void swap(radix_set &other) { tree_->Swap(*other.tree_); }
+
+  /// @brief Переносит из other элементы, которых нет в контейнере.
+  void merge(radix_set &other) { tree_->Merge(*other.tree_, true); }
+
+  /// @brief Поиск элемента по значению.
+  /// @return Итератор на элемент или end().
+  iterator find(const key_type &key) const { return tree_->Find(key); }
+
+  /// @brief Проверяет, содержится ли элемент в контейнере.
+  bool contains(const key_type &key) const { return tree_->Contains(key); }
+
+  /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
+  iterator lower_bound(const key_type &key) const {
+    return tree_->Lower_Bound(key);
+  }
+
+  /// @brief Возвращает итератор на первый элемент, который больше заданного.
+  iterator upper_bound(const key_type &key) const {
+    return tree_->Upper_Bound(key);
+  }
+
+  bool operator==(const radix_set &other) const {
+    return *tree_ == *other.tree_;
+  }
+
+  bool operator!=(const radix_set &other) const {
+    return *tree_ != *other.tree_;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> res;
+    res.reserve(sizeof...(Args));
+    (res.push_back(insert(std::forward<Args>(args))), ...);
+    return res;
+  }
+
+ private:
+  tree_type *tree_;
+};
+
+/// @brief Можно ли хранить ключи в radix-дереве без изменения порядка:
+/// целочисленный ключ (кроме bool) и сравнение std::less.
+template <typename Key, typename Compare>
+inline constexpr bool kRadixKey =
+    std::is_integral_v<Key> && !std::is_same_v<Key, bool> &&
+    (std::is_same_v<Compare, std::less<Key>> ||
+     std::is_same_v<Compare, std::less<>>);
+
+/// @brief Упорядоченное множество с автоматическим выбором движка:
+/// radix_set для целочисленных ключей с std::less, иначе set.
+template <typename Key, typename Compare = std::less<Key>>
+using ordered_set = std::conditional_t<kRadixKey<Key, Compare>,
+                                       radix_set<Key>, set<Key, Compare>>;
+
+}  // namespace s21
+
+#endif  // S21_RADIX_SET_H_
@@ -0,0 +1,841 @@
+#ifndef S21_RADIX_TREE_H_
+#define S21_RADIX_TREE_H_
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/// @brief Адаптивное radix-дерево (ART) для целочисленных ключей. Ключ
+/// разбирается по байтам от старшего к младшему (у знаковых ключей
+/// инвертируется знаковый бит, поэтому порядок байтов совпадает с
+/// std::less), глубина ограничена шириной ключа, а не log n. Внутренние
+/// узлы растут и сжимаются по ёмкости 4, 16, 48 и 256 потомков, общий префикс
+/// поддерева хранится в узле (сжатие путей), поэтому у разреженных ключей
+/// нет цепочек из узлов с одним потомком. Листья связаны в упорядоченный
+/// двусвязный список: обход не спускается по дереву, а итераторы не
+/// инвалидируются вставкой и удалением других ключей. Повторы ключа
+/// мультимножества хранятся счётчиком в одном листе.
+template <typename Key>
+class RadixTree {
+  static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>,
+                "s21::RadixTree: key must be an integral type");
+
+ private:
+  struct Leaf;
+  struct Iterator;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+  using size_type = std::size_t;
+
+  /// @brief Конструктор по умолчанию.
+  RadixTree() : header_(new Leaf()) {
+    header_->prev = header_->next = header_;
+  }
+
+  /// @brief Конструктор копирования.
+  RadixTree(const RadixTree &other) : RadixTree() {
+    try {
+      CopyFrom(other);
+    } catch (...) {
+      Clear();
+      delete header_;
+      throw;
+    }
+  }
+
+  /// @brief Конструктор перемещения.
+  RadixTree(RadixTree &&other) noexcept : RadixTree() { Swap(other); }
+
+  /// @brief Оператор присваивания копированием.
+  RadixTree &operator=(const RadixTree &other) {
+    if (this != &other) {
+      RadixTree copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  RadixTree &operator=(RadixTree &&other) noexcept {
+    if (this != &other) {
+      Clear();
+      Swap(other);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~RadixTree() {
+    Clear();
+    delete header_;
+  }
+
+  /// @brief Количество элементов с учётом повторов.
+  size_type Size() const noexcept { return size_; }
+
+  /// @brief Максимально возможное количество элементов.
+  size_type Max_Size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Leaf);
+  }
+
+  iterator Begin() const noexcept { return iterator(header_->next, 0); }
+
+  iterator End() const noexcept { return iterator(header_, 0); }
+
+  /// @brief Вставка ключа за один спуск не глубже ширины ключа в байтах.
+  /// @param uniq Не вставлять повтор существующего ключа.
+  /// @return Итератор на элемент и флаг вставки.
+  std::pair<iterator, bool> InsertKey(Key key, bool uniq) {
+    const bits_type bits = ToBits(key);
+    void **slot = &root_;
+    if (root_ == nullptr) {
+      Leaf *leaf = NewLeaf(key);
+      LinkBefore(leaf, header_);
+      root_ = TagLeaf(leaf);
+      ++size_;
+      return {iterator(leaf, 0), true};
+    }
+    while (true) {
+      if (IsLeaf(*slot)) {
+        Leaf *old = AsLeaf(*slot);
+        if (old->key == key) {
+          if (uniq) {
+            return {iterator(old, 0), false};
+          }
+          ++size_;
+          return {iterator(old, old->count++), true};
+        }
+        return {iterator(Split(slot, ToBits(old->key), key, old), 0), true};
+      }
+      Inner *node = AsInner(*slot);
+      if (((bits ^ node->prefix) & HighMask(node->depth)) != 0) {
+        return {iterator(Split(slot, node->prefix, key, nullptr), 0), true};
+      }
+      unsigned char byte = Byte(bits, node->depth);
+      void **child = FindChild(node, byte);
+      if (child != nullptr) {
+        slot = child;
+        continue;
+      }
+      void *next = NextChild(node, byte);
+      Leaf *pos = next != nullptr ? MinLeaf(next) : MaxLeaf(node)->next;
+      Leaf *leaf = NewLeaf(key);
+      try {
+        AddChild(slot, byte, TagLeaf(leaf));
+      } catch (...) {
+        delete leaf;
+        throw;
+      }
+      LinkBefore(leaf, pos);
+      ++size_;
+      return {iterator(leaf, 0), true};
+    }
+  }
+
+  /// @brief Удаление одного элемента по итератору. Итераторы на другие
+  /// ключи остаются действительными.
+  void Erase(iterator pos) noexcept {
+    Leaf *leaf = pos.leaf_;
+    if (leaf == header_) {
+      return;
+    }
+    --size_;
+    if (leaf->count > 1) {
+      --leaf->count;
+      return;
+    }
+    const bits_type bits = ToBits(leaf->key);
+    void **parent = nullptr;
+    void **slot = &root_;
+    while (!IsLeaf(*slot)) {
+      parent = slot;
+      slot = FindChild(AsInner(*slot), Byte(bits, AsInner(*slot)->depth));
+    }
+    if (parent == nullptr) {
+      root_ = nullptr;
+    } else {
+      RemoveChild(parent, Byte(bits, AsInner(*parent)->depth));
+    }
+    leaf->prev->next = leaf->next;
+    leaf->next->prev = leaf->prev;
+    delete leaf;
+  }
+
+  /// @brief Поиск ключа: спуск по байтам без сравнения префиксов, ключ
+  /// проверяется один раз в листе.
+  iterator Find(Key key) const noexcept {
+    const bits_type bits = ToBits(key);
+    void *ref = root_;
+    while (ref != nullptr && !IsLeaf(ref)) {
+      Inner *node = AsInner(ref);
+      void **child = FindChild(node, Byte(bits, node->depth));
+      ref = child != nullptr ? *child : nullptr;
+    }
+    if (ref != nullptr && AsLeaf(ref)->key == key) {
+      return iterator(AsLeaf(ref), 0);
+    }
+    return End();
+  }
+
+  bool Contains(Key key) const noexcept { return Find(key) != End(); }
+
+  /// @brief Количество повторов ключа.
+  size_type Count(Key key) const noexcept {
+    iterator it = Find(key);
+    return it == End() ? 0 : it.leaf_->count;
+  }
+
+  /// @brief Первый элемент не меньше key. Лист, на котором закончился
+  /// спуск, - единственный ключ поддерева с общим с key префиксом, поэтому
+  /// ответ - он сам, его соседи в списке или крайний лист поддерева.
+  iterator Lower_Bound(Key key) const noexcept {
+    const bits_type bits = ToBits(key);
+    void *ref = root_;
+    if (ref == nullptr) {
+      return End();
+    }
+    while (!IsLeaf(ref)) {
+      Inner *node = AsInner(ref);
+      if (((bits ^ node->prefix) & HighMask(node->depth)) != 0) {
+        return iterator(
+            bits < node->prefix ? MinLeaf(ref) : MaxLeaf(ref)->next, 0);
+      }
+      unsigned char byte = Byte(bits, node->depth);
+      void **child = FindChild(node, byte);
+      if (child == nullptr) {
+        void *next = NextChild(node, byte);
+        return iterator(next != nullptr ? MinLeaf(next) : MaxLeaf(ref)->next,
+                        0);
+      }
+      ref = *child;
+    }
+    Leaf *leaf = AsLeaf(ref);
+    return iterator(leaf->key < key ? leaf->next : leaf, 0);
+  }
+
+  /// @brief Первый элемент больше key.
+  iterator Upper_Bound(Key key) const noexcept {
+    iterator it = Lower_Bound(key);
+    if (it.leaf_ != header_ && it.leaf_->key == key) {
+      return iterator(it.leaf_->next, 0);
+    }
+    return it;
+  }
+
+  /// @brief Слияние: уникальное дерево забирает ключи, которых у него нет,
+  /// мультимножество - все элементы other.
+  void Merge(RadixTree &other, bool uniq) {
+    if (this == &other) {
+      return;
+    }
+    for (Leaf *leaf = other.header_->next; leaf != other.header_;) {
+      Leaf *next = leaf->next;
+      if (uniq) {
+        if (InsertKey(leaf->key, true).second) {
+          other.Erase(iterator(leaf, 0));
+        }
+      } else {
+        Leaf *own = InsertKey(leaf->key, false).first.leaf_;
+        own->count += leaf->count - 1;
+        size_ += leaf->count - 1;
+      }
+      leaf = next;
+    }
+    if (!uniq) {
+      other.Clear();
+    }
+  }
+
+  /// @brief Обмен содержимым двух деревьев.
+  void Swap(RadixTree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(header_, other.header_);
+    std::swap(size_, other.size_);
+  }
+
+  /// @brief Очистка дерева.
+  void Clear() noexcept {
+    DeleteInner(root_);
+    root_ = nullptr;
+    for (Leaf *leaf = header_->next; leaf != header_;) {
+      Leaf *next = leaf->next;
+      delete leaf;
+      leaf = next;
+    }
+    header_->prev = header_->next = header_;
+    size_ = 0;
+  }
+
+  bool operator==(const RadixTree &other) const noexcept {
+    if (size_ != other.size_) {
+      return false;
+    }
+    for (Leaf *a = header_->next, *b = other.header_->next; a != header_;
+         a = a->next, b = b->next) {
+      if (a->key != b->key || a->count != b->count) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const RadixTree &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  using bits_type = std::make_unsigned_t<Key>;
+
+  static constexpr unsigned kBytes = sizeof(Key);
+
+  enum NodeType : unsigned char { kNode4, kNode16, kNode48, kNode256 };
+
+  /// @brief Лист: ключ и количество его повторов.
+  struct Leaf {
+    Leaf *prev = nullptr;
+    Leaf *next = nullptr;
+    Key key = Key();
+    size_type count = 0;
+  };
+
+  /// @brief Общая часть внутренних узлов.
+  struct Inner {
+    NodeType type;
+    /// @brief Номер байта ключа, по которому ветвится узел.
+    unsigned char depth;
+    unsigned short count;
+    /// @brief Биты любого ключа поддерева: старшие depth байт общие.
+    bits_type prefix;
+  };
+
+  /// @brief Узел на 4 или 16 потомков: байты упорядочены.
+  template <int N>
+  struct SmallNode : Inner {
+    unsigned char keys[N];
+    void *children[N];
+  };
+
+  using Node4 = SmallNode<4>;
+  using Node16 = SmallNode<16>;
+
+  /// @brief Узел на 48 потомков: index[byte] - номер потомка + 1.
+  struct Node48 : Inner {
+    unsigned char index[256];
+    void *children[48];
+  };
+
+  struct Node256 : Inner {
+    void *children[256];
+  };
+
+  /// @brief Итератор: лист и номер повтора ключа в нём.
+  struct Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = RadixTree::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    Iterator() = delete;
+    Iterator(Leaf *leaf, size_type index) : leaf_(leaf), index_(index) {}
+
+    reference operator*() const { return leaf_->key; }
+    pointer operator->() const { return &leaf_->key; }
+
+    Iterator &operator++() {
+      if (++index_ >= leaf_->count) {
+        leaf_ = leaf_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    Iterator &operator--() {
+      if (index_ == 0) {
+        leaf_ = leaf_->prev;
+        index_ = leaf_->count > 0 ? leaf_->count - 1 : 0;
+      } else {
+        --index_;
+      }
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+    Leaf *leaf_;
+    size_type index_;
+  };
+
+  /// @brief Биты ключа в порядке std::less.
+  static bits_type ToBits(Key key) noexcept {
+    bits_type bits = static_cast<bits_type>(key);
+    if constexpr (std::is_signed_v<Key>) {
+      bits ^= bits_type(1) << (kBytes * 8 - 1);
+    }
+    return bits;
+  }
+
+  static unsigned char Byte(bits_type bits, unsigned depth) noexcept {
+    return static_cast<unsigned char>(bits >> (8 * (kBytes - 1 - depth)));
+  }
+
+  /// @brief Маска старших depth байт.
+  static bits_type HighMask(unsigned depth) noexcept {
+    return depth == 0 ? bits_type(0)
+                      : static_cast<bits_type>(~std::uint64_t(0)
+                                               << (8 * (kBytes - depth)));
+  }
+
+  /// @brief Номер первого различающегося байта.
+  static unsigned FirstDiff(bits_type a, bits_type b) noexcept {
+    unsigned depth = 0;
+    while (Byte(a, depth) == Byte(b, depth)) ++depth;
+    return depth;
+  }
+
+  /// @brief Листья хранятся в тех же ссылках, что и узлы, с меткой в
+  /// младшем бите указателя.
+  static bool IsLeaf(void *ref) noexcept {
+    return (reinterpret_cast<std::uintptr_t>(ref) & 1) != 0;
+  }
+
+  static Leaf *AsLeaf(void *ref) noexcept {
+    return reinterpret_cast<Leaf *>(reinterpret_cast<std::uintptr_t>(ref) &
+                                    ~std::uintptr_t(1));
+  }
+
+  static void *TagLeaf(Leaf *leaf) noexcept {
+    return reinterpret_cast<void *>(reinterpret_cast<std::uintptr_t>(leaf) |
+                                    1);
+  }
+
+  static Inner *AsInner(void *ref) noexcept {
+    return static_cast<Inner *>(ref);
+  }
+
+  static Leaf *NewLeaf(Key key) {
+    Leaf *leaf = new Leaf();
+    leaf->key = key;
+    leaf->count = 1;
+    return leaf;
+  }
+
+  /// @brief Вставка листа в список перед pos.
+  static void LinkBefore(Leaf *leaf, Leaf *pos) noexcept {
+    leaf->prev = pos->prev;
+    leaf->next = pos;
+    pos->prev->next = leaf;
+    pos->prev = leaf;
+  }
+
+  template <typename Node>
+  static Node *NewInner(NodeType type, unsigned depth, bits_type prefix) {
+    Node *node = new Node();
+    node->type = type;
+    node->depth = static_cast<unsigned char>(depth);
+    node->count = 0;
+    node->prefix = prefix;
+    return node;
+  }
+
+  /// @brief Разделение ссылки *slot (лист или поддерево с битами
+  /// other_bits, которые отличаются от key раньше байта ветвления) узлом на
+  /// двух потомков. Новый лист соседствует в списке с крайним листом
+  /// старого поддерева.
+  Leaf *Split(void **slot, bits_type other_bits, Key key, Leaf *old) {
+    const bits_type bits = ToBits(key);
+    unsigned depth = FirstDiff(bits, other_bits);
+    Leaf *leaf = NewLeaf(key);
+    Node4 *node = nullptr;
+    try {
+      node = NewInner<Node4>(kNode4, depth, bits);
+    } catch (...) {
+      delete leaf;
+      throw;
+    }
+    bool before = bits < other_bits;
+    unsigned char byte = Byte(bits, depth);
+    unsigned char other_byte = Byte(other_bits, depth);
+    node->keys[0] = before ? byte : other_byte;
+    node->keys[1] = before ? other_byte : byte;
+    node->children[before ? 0 : 1] = TagLeaf(leaf);
+    node->children[before ? 1 : 0] = *slot;
+    node->count = 2;
+    if (old == nullptr) {
+      old = before ? MinLeaf(*slot) : MaxLeaf(*slot);
+    }
+    LinkBefore(leaf, before ? old : old->next);
+    *slot = node;
+    ++size_;
+    return leaf;
+  }
+
+  /// @brief Ссылка на потомка по байту или nullptr.
+  static void **FindChild(Inner *node, unsigned char byte) noexcept {
+    switch (node->type) {
+      case kNode4:
+        return FindSmall(static_cast<Node4 *>(node), byte);
+      case kNode16:
+        return FindSmall(static_cast<Node16 *>(node), byte);
+      case kNode48: {
+        auto *n = static_cast<Node48 *>(node);
+        return n->index[byte] != 0 ? &n->children[n->index[byte] - 1]
+                                   : nullptr;
+      }
+      default: {
+        auto *n = static_cast<Node256 *>(node);
+        return n->children[byte] != nullptr ? &n->children[byte] : nullptr;
+      }
+    }
+  }
+
+  template <typename Node>
+  static void **FindSmall(Node *node, unsigned char byte) noexcept {
+    for (int i = 0; i < node->count && node->keys[i] <= byte; ++i) {
+      if (node->keys[i] == byte) {
+        return &node->children[i];
+      }
+    }
+    return nullptr;
+  }
+
+  /// @brief Первый потомок с байтом больше byte или nullptr.
+  static void *NextChild(Inner *node, unsigned char byte) noexcept {
+    switch (node->type) {
+      case kNode4:
+        return NextSmall(static_cast<Node4 *>(node), byte);
+      case kNode16:
+        return NextSmall(static_cast<Node16 *>(node), byte);
+      case kNode48: {
+        auto *n = static_cast<Node48 *>(node);
+        for (int b = byte + 1; b < 256; ++b) {
+          if (n->index[b] != 0) {
+            return n->children[n->index[b] - 1];
+          }
+        }
+        return nullptr;
+      }
+      default: {
+        auto *n = static_cast<Node256 *>(node);
+        for (int b = byte + 1; b < 256; ++b) {
+          if (n->children[b] != nullptr) {
+            return n->children[b];
+          }
+        }
+        return nullptr;
+      }
+    }
+  }
+
+  template <typename Node>
+  static void *NextSmall(Node *node, unsigned char byte) noexcept {
+    for (int i = 0; i < node->count; ++i) {
+      if (node->keys[i] > byte) {
+        return node->children[i];
+      }
+    }
+    return nullptr;
+  }
+
+  /// @brief Крайний потомок узла: первый или последний по байту.
+  static void *EdgeChild(Inner *node, bool last) noexcept {
+    switch (node->type) {
+      case kNode4: {
+        auto *n = static_cast<Node4 *>(node);
+        return n->children[last ? n->count - 1 : 0];
+      }
+      case kNode16: {
+        auto *n = static_cast<Node16 *>(node);
+        return n->children[last ? n->count - 1 : 0];
+      }
+      case kNode48: {
+        auto *n = static_cast<Node48 *>(node);
+        for (int i = 0; i < 256; ++i) {
+          int b = last ? 255 - i : i;
+          if (n->index[b] != 0) {
+            return n->children[n->index[b] - 1];
+          }
+        }
+        return nullptr;
+      }
+      default: {
+        auto *n = static_cast<Node256 *>(node);
+        for (int i = 0; i < 256; ++i) {
+          void *child = n->children[last ? 255 - i : i];
+          if (child != nullptr) {
+            return child;
+          }
+        }
+        return nullptr;
+      }
+    }
+  }
+
+  static Leaf *MinLeaf(void *ref) noexcept {
+    while (!IsLeaf(ref)) ref = EdgeChild(AsInner(ref), false);
+    return AsLeaf(ref);
+  }
+
+  static Leaf *MaxLeaf(void *ref) noexcept {
+    while (!IsLeaf(ref)) ref = EdgeChild(AsInner(ref), true);
+    return AsLeaf(ref);
+  }
+
+  /// @brief Добавление потомка в узел *slot; заполненный узел заменяется
+  /// узлом следующей ёмкости.
+  static void AddChild(void **slot, unsigned char byte, void *child) {
+    Inner *node = AsInner(*slot);
+    switch (node->type) {
+      case kNode4: {
+        auto *n = static_cast<Node4 *>(node);
+        if (n->count == 4) {
+          *slot = Grow<Node16>(n, kNode16);
+          delete n;
+          AddChild(slot, byte, child);
+        } else {
+          AddSmall(n, byte, child);
+        }
+        return;
+      }
+      case kNode16: {
+        auto *n = static_cast<Node16 *>(node);
+        if (n->count == 16) {
+          auto *bigger = NewInner<Node48>(kNode48, n->depth, n->prefix);
+          for (int i = 0; i < 16; ++i) {
+            bigger->index[n->keys[i]] = static_cast<unsigned char>(i + 1);
+            bigger->children[i] = n->children[i];
+          }
+          bigger->count = 16;
+          *slot = bigger;
+          delete n;
+          AddChild(slot, byte, child);
+        } else {
+          AddSmall(n, byte, child);
+        }
+        return;
+      }
+      case kNode48: {
+        auto *n = static_cast<Node48 *>(node);
+        if (n->count == 48) {
+          auto *bigger = NewInner<Node256>(kNode256, n->depth, n->prefix);
+          for (int b = 0; b < 256; ++b) {
+            if (n->index[b] != 0) {
+              bigger->children[b] = n->children[n->index[b] - 1];
+            }
+          }
+          bigger->count = 48;
+          *slot = bigger;
+          delete n;
+          AddChild(slot, byte, child);
+          return;
+        }
+        int free = 0;
+        while (n->children[free] != nullptr) ++free;
+        n->children[free] = child;
+        n->index[byte] = static_cast<unsigned char>(free + 1);
+        ++n->count;
+        return;
+      }
+      default: {
+        auto *n = static_cast<Node256 *>(node);
+        n->children[byte] = child;
+        ++n->count;
+      }
+    }
+  }
+
+  template <typename Node>
+  static void AddSmall(Node *node, unsigned char byte, void *child) noexcept {
+    int pos = node->count;
+    while (pos > 0 && node->keys[pos - 1] > byte) {
+      node->keys[pos] = node->keys[pos - 1];
+      node->children[pos] = node->children[pos - 1];
+      --pos;
+    }
+    node->keys[pos] = byte;
+    node->children[pos] = child;
+    ++node->count;
+  }
+
+  /// @brief Копия узла с упорядоченными байтами в узел другой ёмкости.
+  template <typename To, typename From>
+  static To *Grow(From *from, NodeType type) {
+    To *to = NewInner<To>(type, from->depth, from->prefix);
+    for (int i = 0; i < from->count; ++i) {
+      to->keys[i] = from->keys[i];
+      to->children[i] = from->children[i];
+    }
+    to->count = from->count;
+    return to;
+  }
+
+  /// @brief Удаление потомка из узла *slot. Узел с одним потомком заменяется
+  /// этим потомком (его префикс хранится в нём самом), недозаполненный узел
+  /// сжимается, если хватает памяти.
+  static void RemoveChild(void **slot, unsigned char byte) noexcept {
+    Inner *node = AsInner(*slot);
+    switch (node->type) {
+      case kNode4: {
+        auto *n = static_cast<Node4 *>(node);
+        RemoveSmall(n, byte);
+        if (n->count == 1) {
+          *slot = n->children[0];
+          delete n;
+        }
+        return;
+      }
+      case kNode16: {
+        auto *n = static_cast<Node16 *>(node);
+        RemoveSmall(n, byte);
+        if (n->count == 3) {
+          auto *smaller = new (std::nothrow) Node4();
+          if (smaller == nullptr) {
+            return;
+          }
+          *static_cast<Inner *>(smaller) = *n;
+          smaller->type = kNode4;
+          for (int i = 0; i < 3; ++i) {
+            smaller->keys[i] = n->keys[i];
+            smaller->children[i] = n->children[i];
+          }
+          *slot = smaller;
+          delete n;
+        }
+        return;
+      }
+      case kNode48: {
+        auto *n = static_cast<Node48 *>(node);
+        n->children[n->index[byte] - 1] = nullptr;
+        n->index[byte] = 0;
+        if (--n->count == 12) {
+          auto *smaller = new (std::nothrow) Node16();
+          if (smaller == nullptr) {
+            return;
+          }
+          *static_cast<Inner *>(smaller) = *n;
+          smaller->type = kNode16;
+          for (int b = 0, i = 0; b < 256; ++b) {
+            if (n->index[b] != 0) {
+              smaller->keys[i] = static_cast<unsigned char>(b);
+              smaller->children[i++] = n->children[n->index[b] - 1];
+            }
+          }
+          *slot = smaller;
+          delete n;
+        }
+        return;
+      }
+      default: {
+        auto *n = static_cast<Node256 *>(node);
+        n->children[byte] = nullptr;
+        if (--n->count == 37) {
+          auto *smaller = new (std::nothrow) Node48();
+          if (smaller == nullptr) {
+            return;
+          }
+          *static_cast<Inner *>(smaller) = *n;
+          smaller->type = kNode48;
+          for (int b = 0, i = 0; b < 256; ++b) {
+            if (n->children[b] != nullptr) {
+              smaller->index[b] = static_cast<unsigned char>(i + 1);
+              smaller->children[i++] = n->children[b];
+            }
+          }
+          *slot = smaller;
+          delete n;
+        }
+      }
+    }
+  }
+
+  template <typename Node>
+  static void RemoveSmall(Node *node, unsigned char byte) noexcept {
+    int pos = 0;
+    while (node->keys[pos] != byte) ++pos;
+    for (--node->count; pos < node->count; ++pos) {
+      node->keys[pos] = node->keys[pos + 1];
+      node->children[pos] = node->children[pos + 1];
+    }
+  }
+
+  /// @brief Удаление внутренних узлов поддерева (листья удаляются по
+  /// списку).
+  static void DeleteInner(void *ref) noexcept {
+    if (ref == nullptr || IsLeaf(ref)) {
+      return;
+    }
+    Inner *node = AsInner(ref);
+    switch (node->type) {
+      case kNode4: {
+        auto *n = static_cast<Node4 *>(node);
+        for (int i = 0; i < n->count; ++i) DeleteInner(n->children[i]);
+        delete n;
+        return;
+      }
+      case kNode16: {
+        auto *n = static_cast<Node16 *>(node);
+        for (int i = 0; i < n->count; ++i) DeleteInner(n->children[i]);
+        delete n;
+        return;
+      }
+      case kNode48: {
+        auto *n = static_cast<Node48 *>(node);
+        for (void *child : n->children) DeleteInner(child);
+        delete n;
+        return;
+      }
+      default: {
+        auto *n = static_cast<Node256 *>(node);
+        for (void *child : n->children) DeleteInner(child);
+        delete n;
+      }
+    }
+  }
+
+  /// @brief Копирование элементов other в пустое дерево.
+  void CopyFrom(const RadixTree &other) {
+    for (Leaf *leaf = other.header_->next; leaf != other.header_;
+         leaf = leaf->next) {
+      Leaf *own = InsertKey(leaf->key, true).first.leaf_;
+      own->count = leaf->count;
+      size_ += leaf->count - 1;
+    }
+  }
+
+  /// @brief Корень: лист, внутренний узел или nullptr.
+  void *root_ = nullptr;
+  /// @brief Заголовок кольцевого списка листьев, служит end().
+  Leaf *header_;
+  size_type size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // S21_RADIX_TREE_H_
@@ -1,9 +1,127 @@
 #ifndef S21_RBTREE_H_
 #define S21_RBTREE_H_
 
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_bloom_filter.h"
+#include "s21_fingerprint.h"
+#include "s21_node_arena.h"
+#include "s21_tree_stats.h"
+
 namespace s21 {
 
-template <typename Key, typename Compare = std::less<Key>>
+/// @brief Есть ли у компаратора трёхстороннее сравнение compare(a, b),
+/// возвращающее отрицательное число, ноль или положительное число.
+template <typename Compare, typename Key, typename = void>
+struct HasThreeWayCompare : std::false_type {};
+
+template <typename Compare, typename Key>
+struct HasThreeWayCompare<
+    Compare, Key,
+    std::void_t<decltype(std::declval<const Compare&>().compare(
+        std::declval<const Key&>(), std::declval<const Key&>()))>>
+    : std::true_type {};
+
+/// @brief Есть ли у ключа метод a.compare(b) (как у std::string), который
+/// можно использовать вместо std::less.
+template <typename Key, typename = void>
+struct HasKeyCompare : std::false_type {};
+
+template <typename Key>
+struct HasKeyCompare<
+    Key, std::void_t<decltype(std::declval<const Key&>().compare(
+             std::declval<const Key&>()))>> : std::true_type {};
+
+/// @brief Политика балансировки красно-чёрного дерева: высота до 2 log n,
+/// мало поворотов при изменениях.
+struct RedBlackBalance {};
+
+/// @brief Политика балансировки AVL: высота до 1.44 log n, короче спуск при
+/// поиске ценой большего числа поворотов при изменениях.
+struct AVLBalance {};
+
+/// @brief Политика без порядковой статистики: узлы не хранят размеры
+/// поддеревьев.
+struct NoRank {};
+
+/// @brief Порядковая статистика: каждый узел хранит число живых элементов
+/// своего поддерева, поэтому k-й элемент (Select) и число элементов меньше
+/// ключа (Rank) находятся за O(log n). Размеры поддерживаются при вставке,
+/// удалении и поворотах ценой одного слова на узел.
+struct SubtreeRank {};
+
+/// @brief Политика ключа множества: ключом служит сам элемент.
+struct IdentityKey {
+  template <typename Value>
+  using type = Value;
+
+  template <typename Value>
+  static const Value& Get(const Value& value) noexcept {
+    return value;
+  }
+};
+
+/// @brief Политика ключа словаря: элемент - пара, ключом служит first.
+struct SelectFirst {
+  template <typename Value>
+  using type = std::remove_const_t<typename Value::first_type>;
+
+  template <typename Value>
+  static const typename Value::first_type& Get(const Value& value) noexcept {
+    return value.first;
+  }
+};
+
+/// @brief Параметры дерева по умолчанию. Для изменения параметра нужно
+/// унаследоваться от TreeOptions и переопределить соответствующий тип.
+struct TreeOptions {
+  /// @brief Политика сбора статистики: NoStats или TreeStats.
+  using stats_policy = NoStats;
+  /// @brief Политика балансировки: RedBlackBalance или AVLBalance.
+  using balance_policy = RedBlackBalance;
+  /// @brief Политика извлечения ключа из элемента: IdentityKey или
+  /// SelectFirst.
+  using key_policy = IdentityKey;
+  /// @brief Отпечаток содержимого для быстрого operator!=: NoFingerprint
+  /// или HashFingerprint.
+  using fingerprint_policy = NoFingerprint;
+  /// @brief Размещение узлов: HeapNodes или HugePageArena.
+  using allocation_policy = HeapNodes;
+  /// @brief Фильтр перед Find и Contains для частых промахов: NoFilter
+  /// или BloomFilter (только с компаратором, для которого верно
+  /// EquivalenceIsEquality: std::less, std::greater).
+  using filter_policy = NoFilter;
+  /// @brief Порядковая статистика (Select, Rank): NoRank или SubtreeRank.
+  using rank_policy = NoRank;
+};
+
+/// @brief Счётчик размера поддерева в узле: пустая база без порядковой
+/// статистики, чтобы узел не увеличивался.
+template <bool Enabled>
+struct RankCount {
+  void ResetCount() noexcept {}
+};
+
+template <>
+struct RankCount<true> {
+  void ResetCount() noexcept { count_ = 1; }
+
+  /// @brief Число живых узлов поддерева.
+  std::size_t count_ = 1;
+};
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
 class RBTree {
  private:
   struct Node;
@@ -11,32 +129,47 @@ class RBTree {
   struct ConstIterator;
 
  public:
-  using key_type = Key;
+  using key_policy = typename Options::key_policy;
+  using key_type = typename key_policy::template type<Key>;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
+  using pointer = value_type*;
   using iterator = Iterator;
   using const_iterator = ConstIterator;
   using size_type = std::size_t;
+  using stats_type = typename Options::stats_policy;
+  using balance_type = typename Options::balance_policy;
+  using fingerprint_type = typename Options::fingerprint_policy;
+  using allocator_type = typename Options::allocation_policy;
+  using filter_type = typename Options::filter_policy;
+  using rank_type = typename Options::rank_policy;
+
+  static_assert(!filter_type::enabled || EquivalenceIsEquality<Compare>::value,
+                "s21::RBTree: filter_policy requires a comparator whose "
+                "equivalence is equality (see EquivalenceIsEquality)");
 
   /// @brief Конструктор по умолчанию.
-  RBTree() : header_(new Node()), size_(0) {}
+  RBTree() : header_(new Node()), size_(0), dead_(0), lazy_threshold_(0) {}
 
   /// @brief Конструктор копирования.
   /// @param other Дерево, которое копируется.
-  RBTree(const RBTree& other) : header_(new Node()), size_(0) {
+  RBTree(const RBTree& other)
+      : header_(new Node()), size_(0), dead_(0), lazy_threshold_(0) {
     CopyTree(other);
+    CopyPending(other);
   }
 
   /// @brief Оператор присваивания копированием.
   /// @param other Дерево, которое копируется.
   /// @return Копия дерева.
-  RBTree operator=(const RBTree& other) {
+  RBTree& operator=(const RBTree& other) {
     if (this == &other) {
       return *this;
     }
     Clear();
     CopyTree(other);
+    CopyPending(other);
     return *this;
   }
 
@@ -47,7 +180,7 @@ class RBTree {
   /// @brief Оператор присваивания перемещением.
   /// @param other Дерево, которое перемещается.
   /// @return Перемещенное дерево.
-  RBTree operator=(RBTree&& other) noexcept {
+  RBTree& operator=(RBTree&& other) noexcept {
     if (this == &other) {
       return *this;
     }
@@ -60,7 +193,8 @@ class RBTree {
   /// @param other Дерево, с которым сравнивается.
   /// @return true, если деревья не равны, иначе false.
   bool operator!=(const RBTree& other) const {
-    if (Size() != other.Size()) {
+    if (Size() != other.Size() ||
+        fingerprint_.Value() != other.fingerprint_.Value()) {
       return true;
     }
     for (auto it = Begin(), itOther = other.Begin(); it != End();
@@ -76,7 +210,8 @@ class RBTree {
   /// @param other Дерево, с которым сравнивается.
   /// @return true, если деревья равны, иначе false.
   bool operator==(const RBTree& other) const {
-    if (Size() != other.Size()) {
+    if (Size() != other.Size() ||
+        fingerprint_.Value() != other.fingerprint_.Value()) {
       return false;
     }
     for (auto it = Begin(), itOther = other.Begin(); it != End();
@@ -94,8 +229,8 @@ class RBTree {
     delete header_;
   }
 
-  /// @brief Количество элементов в дереве.
-  size_type Size() const noexcept { return size_; }
+  /// @brief Количество элементов в дереве (без лениво удалённых).
+  size_type Size() const noexcept { return size_ - dead_; }
 
   /// @brief Максимально возможное количество элементов в дереве.
   size_type Max_Size() const noexcept {
@@ -108,13 +243,16 @@ class RBTree {
     if (size_ == 0) {
       return End();
     }
-    Node* node = Minimum();
+    Node* node = SkipDead(Minimum());
     return iterator(node);
   }
 
   /// @brief Возвращает константный итератор на первый элемент дерева.
   const_iterator Begin() const noexcept {
-    Node* node = Minimum();
+    if (size_ == 0) {
+      return End();
+    }
+    Node* node = SkipDead(Minimum());
     return const_iterator(node);
   }
 
@@ -125,27 +263,31 @@ class RBTree {
   const_iterator End() const { return const_iterator(header_); }
 
   /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
-  iterator Lower_Bound(const_reference key) {
+  iterator Lower_Bound(const key_type& key) {
     Node* start = Root();
     iterator res = End();
+    int depth = 0;
     while (start != nullptr) {
-      if (!lt_(start->key_, key)) {
+      ++depth;
+      if (!Less(KeyOf(start), key)) {
         res = iterator(start);
         start = start->left_;
       } else {
         start = start->right_;
       }
     }
-
-    return res;
+    stats_.Descent(depth);
+    return iterator(SkipDead(res.node_));
   }
 
   /// @brief Возвращает итератор на первый элемент, который больше заданного.
-  iterator Upper_Bound(const_reference key) {
+  iterator Upper_Bound(const key_type& key) {
     Node* start = Root();
     iterator res = End();
+    int depth = 0;
     while (start != nullptr) {
-      if (lt_(key, start->key_)) {
+      ++depth;
+      if (Less(key, KeyOf(start))) {
         res = iterator(start);
         start = start->left_;
 
@@ -153,95 +295,328 @@ class RBTree {
         start = start->right_;
       }
     }
-    return res;
+    stats_.Descent(depth);
+    return iterator(SkipDead(res.node_));
   }
 
   /// @brief Поиск элемента по ключу.
   /// @param key Ключ по которому производится поиск.
   /// @return Указатель на элемент, если он найден, иначе nullptr.
   iterator Find(const key_type& key) {
+    if (!filter_.MayContain(key)) {
+      stats_.FilterNegative();
+      return End();
+    }
     Node* node = nullptr;
     int ret = Find(key, Root(), &node);
-    if (ret == 0) {
-      return iterator(node);
-    } else {
-      return End();
+    Node* match = ret == 0 ? LiveMatch(node, key) : header_;
+    if (match == header_ && filter_type::enabled) {
+      stats_.FilterFalsePositive();
     }
+    return iterator(match);
   }
 
   /// @brief Вставка элемента в дерево.
   /// @param key Ключ для вставки.
   /// @return В случае успешной вставки возвращает пару итератор на вставленный
   /// элемент и true, иначе итератор на элемент с таким ключом и false.
-  std::pair<iterator, bool> InsertKey(const key_type& key, bool uniq) {
-    Node* newNode = new Node(key);
+  std::pair<iterator, bool> InsertKey(const value_type& key, bool uniq) {
+    return Emplace(uniq, key);
+  }
+
+  /// @brief Вставка элемента в дерево с перемещением ключа.
+  /// @param key Ключ для вставки.
+  /// @return В случае успешной вставки возвращает пару итератор на вставленный
+  /// элемент и true, иначе итератор на элемент с таким ключом и false.
+  std::pair<iterator, bool> InsertKey(value_type&& key, bool uniq) {
+    return Emplace(uniq, std::move(key));
+  }
+
+  /// @brief Вставка элемента, конструируемого прямо в узле.
+  /// @param uniq Флаг, запрещающий одинаковые ключи.
+  /// @param args Аргументы конструктора ключа.
+  /// @return В случае успешной вставки возвращает пару итератор на вставленный
+  /// элемент и true, иначе итератор на элемент с таким ключом и false.
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(bool uniq, Args&&... args) {
+    Node* newNode = NewNode(std::in_place, std::forward<Args>(args)...);
     std::pair<iterator, bool> in = InsertNode(newNode, uniq);
-    if (in.second == false) delete newNode;
+    if (in.second == false) DeleteNode(newNode);
     return in;
   }
 
+  /// @brief Вставка элемента с уникальным ключом за один спуск. Элемент
+  /// создаётся только если ключа ещё нет, иначе ничего не выделяется.
+  /// @param key Ключ, который получит созданный элемент.
+  /// @param args Аргументы конструктора элемента.
+  /// @return Итератор на элемент с ключом key и флаг успешности вставки.
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const key_type& key, Args&&... args) {
+    Node* parNode = nullptr;
+    int ret = Find(key, Root(), &parNode);
+    if (ret == 0 && !parNode->dead_) return {iterator(parNode), false};
+    Node* newNode = NewNode(std::in_place, std::forward<Args>(args)...);
+    if (ret == 0) {
+      ReplaceNode(parNode, newNode);
+    } else {
+      LinkNode(newNode, parNode, ret);
+    }
+    return {iterator(newNode), true};
+  }
+
+  /// @brief Вставка нескольких уникальных элементов, каждый аргумент
+  /// передаётся в конструктор ключа без промежуточных копий.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> Insert_Many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> res;
-    for (auto&& arg : {std::forward<Args>(args)...}) {
-      Node* newNode = new Node(std::move(arg));
-      std::pair<iterator, bool> in = InsertNode(newNode, true);
-      if (in.second == false) delete newNode;
-      res.push_back(in);
-    }
+    res.reserve(sizeof...(Args));
+    (res.push_back(Emplace(true, std::forward<Args>(args))), ...);
     return res;
   }
 
+  /// @brief Вставка нескольких элементов с повторами.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> Insert_Many_Multi(Args&&... args) {
     std::vector<std::pair<iterator, bool>> res;
-    for (auto&& arg : {args...}) {
-      Node* newNode = new Node(arg);
-      std::pair<iterator, bool> in = InsertNode(newNode, false);
-      if (in.second == false) delete newNode;
-      res.push_back(in);
+    res.reserve(sizeof...(Args));
+    (res.push_back(Emplace(false, std::forward<Args>(args))), ...);
+    return res;
+  }
+
+  /// @brief Поиск упорядоченного пакета ключей. Каждый следующий поиск
+  /// начинается от узла предыдущего (finger search), поэтому пакет из k ключей
+  /// обрабатывается за O(k log(n/k)) вместо O(k log n).
+  /// @param first Начало диапазона ключей, упорядоченных по Compare.
+  /// @param last Конец диапазона.
+  /// @return Итераторы на найденные элементы или End().
+  template <typename InputIt>
+  std::vector<iterator> FindSortedBatch(InputIt first, InputIt last) {
+    std::vector<iterator> res;
+    Node* finger = nullptr;
+    for (; first != last; ++first) {
+      Node* node = FingerFind(*first, finger);
+      res.push_back(node ? iterator(LiveMatch(node, *first)) : End());
     }
     return res;
   }
 
+  /// @brief Проверка наличия упорядоченного пакета ключей (см.
+  /// FindSortedBatch).
+  /// @return Для каждого ключа true, если он есть в дереве.
+  template <typename InputIt>
+  std::vector<bool> ContainsSortedBatch(InputIt first, InputIt last) const {
+    std::vector<bool> res;
+    Node* finger = nullptr;
+    for (; first != last; ++first) {
+      Node* node = FingerFind(*first, finger);
+      res.push_back(node != nullptr && LiveMatch(node, *first) != header_);
+    }
+    return res;
+  }
+
+  /// @brief Вставка упорядоченного пакета ключей, место каждого ключа ищется
+  /// от узла предыдущего (см. FindSortedBatch).
+  /// @param uniq Флаг, запрещающий одинаковые ключи.
+  /// @return Для каждого ключа итератор на элемент и флаг успешности вставки.
+  template <typename InputIt>
+  std::vector<std::pair<iterator, bool>> InsertSortedBatch(InputIt first,
+                                                           InputIt last,
+                                                           bool uniq) {
+    std::vector<std::pair<iterator, bool>> res;
+    Node* finger = nullptr;
+    for (; first != last; ++first) {
+      Node* newNode = NewNode(std::in_place, *first);
+      res.push_back(InsertFromFinger(newNode, finger, uniq));
+    }
+    return res;
+  }
+
+  /// @brief Заполнение дерева отсортированным диапазоном за O(n).
+  /// @param first Начало диапазона ключей, упорядоченных по Compare.
+  /// @param last Конец диапазона.
+  /// @param uniq Флаг, указывающий на то, что подряд идущие равные ключи
+  /// нужно пропускать.
+  template <typename InputIt>
+  void AssignSorted(InputIt first, InputIt last, bool uniq) {
+    std::vector<Node*> nodes;
+    try {
+      for (; first != last; ++first) {
+        Node* node = NewNode(std::in_place, *first);
+        if (uniq && !nodes.empty() && !Less(KeyOf(nodes.back()), KeyOf(node))) {
+          DeleteNode(node);
+          continue;
+        }
+        nodes.push_back(node);
+      }
+    } catch (...) {
+      for (Node* node : nodes) DeleteNode(node);
+      throw;
+    }
+    DropNodes();
+    BuildBalanced(nodes);
+  }
+
   /// @brief Удаление элемента из дерева по итератору.
   void Erase(iterator pos) {
     if (pos == End()) {
       return;
     }
-    delete ExtractNode(pos);
+    if (lazy_threshold_ > 0) {
+      fingerprint_.Remove(KeyOf(pos.node_));
+      filter_.Remove();
+      pos.node_->dead_ = true;
+      RankUpdatePath(pos.node_);
+      ++dead_;
+      if (dead_ == size_ || dead_ > lazy_threshold_ * size_) Compact();
+      if (filter_.NeedsRebuild()) RebuildFilter();
+      return;
+    }
+    DeleteNode(ExtractNode(pos));
+    if (filter_.NeedsRebuild()) RebuildFilter();
   }
 
-  /// @brief Удаление элемента из дерева.
-  /// @param key Ключ по которому производится удаление.
-  void DeleteByKey(const key_type key) {
-    iterator node = Find(key);
-    if (node == End()) {
+  /// @brief Замена элемента pos новым элементом в том же узле: узел
+  /// извлекается, элемент разрушается и создаётся из args, узел вставляется
+  /// после равных. Память не выделяется и не освобождается.
+  /// @return Итератор на новый элемент.
+  template <typename... Args>
+  iterator RecycleNode(iterator pos, Args&&... args) {
+    Node* node = ExtractNode(pos);
+    node->key_.~value_type();
+    try {
+      new (&node->key_) value_type(std::forward<Args>(args)...);
+    } catch (...) {
+      stats_.Deallocation();
+      node->~Node();
+      alloc_.Deallocate(node, sizeof(Node));
+      throw;
+    }
+    node->InitNode();
+    return InsertNode(node, false).first;
+  }
+
+  /// @brief Включение ленивого удаления: Erase только помечает узел, а
+  /// дерево перестраивается за O(n), когда доля помеченных узлов превышает
+  /// порог.
+  /// @param threshold Порог доли удалённых узлов из (0, 1]. 0 выключает
+  /// ленивое удаление и сразу убирает помеченные узлы.
+  void SetLazyErase(double threshold) {
+    lazy_threshold_ = threshold > 0 ? threshold : 0;
+    if (lazy_threshold_ == 0) Compact();
+  }
+
+  /// @brief Удаление помеченных узлов и перестройка дерева за O(n).
+  void Compact() {
+    if (dead_ == 0) {
       return;
     }
-    delete ExtractNode(node);
+    std::vector<Node*> live;
+    std::vector<Node*> dead;
+    live.reserve(size_ - dead_);
+    dead.reserve(dead_);
+    for (Node* node = Minimum(); node != header_; node = node->NextNode()) {
+      (node->dead_ ? dead : live).push_back(node);
+    }
+    for (Node* node : dead) DeleteNode(node);
+    Root() = nullptr;
+    size_ = 0;
+    dead_ = 0;
+    BuildBalanced(live);
   }
 
+  /// @brief Включение буфера записи: InsertBuffered складывает новые элементы
+  /// в буфер без спуска и балансировки, а Flush вливает его в дерево. Буфер
+  /// вливается, как только в нём набирается capacity элементов; Flush сам
+  /// выбирает вставку от пальца для буфера, маленького относительно дерева,
+  /// или слияние за линейное время, и стоимость вливания делится на много
+  /// вставок. Пока буфер не влит, остальные операции дерева его не видят,
+  /// кроме Contains; контейнеры вызывают Flush перед упорядоченными
+  /// операциями сами. Буфер хранится отсортированными сериями разной длины,
+  /// каждая длина равна степени двойки: новый элемент - серия длины 1, равные
+  /// соседние серии сливаются, как разряды двоичного счётчика. Вставка стоит
+  /// O(log b) перемещений в среднем, а Contains - двоичный поиск по O(log b)
+  /// сериям и ничего не меняет, поэтому Contains можно вызывать из
+  /// нескольких потоков; Flush, в том числе из константных членов
+  /// контейнеров, меняет дерево.
+  /// @param capacity Размер буфера, 0 - буфер выключен (и вливается
+  /// сразу).
+  void SetWriteBuffer(size_type capacity) {
+    pending_capacity_ = capacity;
+    if (capacity == 0) {
+      Flush();
+      return;
+    }
+    pending_.reserve(capacity);
+  }
+
+  /// @brief Вставка через буфер записи (обычная вставка, если он выключен).
+  /// @param uniq Флаг, запрещающий одинаковые ключи: повторы отбрасываются
+  /// при вливании.
+  template <typename V>
+  void InsertBuffered(V&& value, bool uniq) {
+    static_assert(kBufferable, "s21::RBTree: write buffer needs assignable "
+                               "elements");
+    if (pending_capacity_ == 0) {
+      InsertKey(std::forward<V>(value), uniq);
+      return;
+    }
+    pending_runs_.reserve(pending_runs_.size() + 1);
+    pending_.push_back(std::forward<V>(value));
+    pending_runs_.push_back(pending_.size());
+    pending_uniq_ = uniq;
+    MergePendingRuns(false);
+    if (pending_.size() >= pending_capacity_) Flush();
+  }
+
+  /// @brief Вливание буфера записи в дерево. Серии буфера сливаются в одну
+  /// (равные ключи сохраняют порядок вставки); маленький относительно
+  /// дерева буфер вставляется от пальца за O(b log(n / b)), большой
+  /// сливается с узлами дерева за O(n + b) со сборкой через BuildBalanced.
+  /// При исключении невлитые элементы остаются в буфере.
+  void Flush() {
+    if constexpr (kBufferable) {
+      if (pending_.empty()) {
+        return;
+      }
+      MergePendingRuns(true);
+      if (pending_.size() * kLinearFlushRatio < Size()) {
+        FlushFromFinger();
+      } else {
+        FlushLinear();
+      }
+    }
+  }
+
+  /// @brief Удаление элемента из дерева.
+  /// @param key Ключ по которому производится удаление.
+  void DeleteByKey(const key_type key) { Erase(Find(key)); }
+
   /// @brief Слияние двух деревьев.
   /// @param other Дерево, которое сливается с текущим.
   void Merge(RBTree& other) {
     if (this != &other) {
+      Flush();
+      other.Flush();
       iterator it = other.Begin();
       while (it != other.End()) {
-        iterator res = Find(*it);
+        iterator res = Find(KeyOf(it.node_));
         if (res == End()) {
           iterator tmp = it++;
-          Node* node = other.ExtractNode(tmp);
+          Node* node = AdoptNode(other, other.ExtractNode(tmp));
           InsertNode(node, true);
 
         } else {
           ++it;
         }
       }
+      if (other.filter_.NeedsRebuild()) other.RebuildFilter();
     }
   }
 
   void MergeMulti(RBTree& other) {
+    Flush();
+    other.Flush();
+    other.Compact();
     iterator it = other.Begin();
     while (other.size_ > 0) {
       Node* node = it.node_;
@@ -259,10 +634,173 @@ class RBTree {
         node->parent_->right_ = nullptr;
       }
       node->InitNode();
+      node = AdoptNode(other, node);
       InsertNode(node, false);
       --other.size_;
     }
     other.header_->parent_ = nullptr;
+    other.fingerprint_.Reset();
+    other.filter_.Clear();
+  }
+
+  /// @brief Слияние с повторами за O(n + m): узлы обоих деревьев сливаются
+  /// в один упорядоченный список (равные ключи текущего дерева идут раньше)
+  /// и дерево собирается заново через BuildBalanced. Выгодно, когда other
+  /// сравним по размеру с текущим деревом; для маленького other MergeMulti
+  /// быстрее. Если узлы принадлежат арене дерева, выполняется MergeMulti.
+  void MergeLinear(RBTree& other) {
+    Flush();
+    other.Flush();
+    if (this == &other || other.Size() == 0) {
+      return;
+    }
+    if constexpr (!allocator_type::kShared) {
+      MergeMulti(other);
+    } else {
+      Compact();
+      other.Compact();
+      std::vector<Node*> mine, theirs, nodes;
+      mine.reserve(size_);
+      theirs.reserve(other.size_);
+      nodes.reserve(size_ + other.size_);
+      if (size_ > 0) {
+        for (Node* node = Minimum(); node != header_; node = node->NextNode()) {
+          mine.push_back(node);
+        }
+      }
+      for (Node* node = other.Minimum(); node != other.header_;
+           node = node->NextNode()) {
+        theirs.push_back(node);
+      }
+      std::merge(mine.begin(), mine.end(), theirs.begin(), theirs.end(),
+                 std::back_inserter(nodes), [this](Node* a, Node* b) {
+                   return Less(KeyOf(a), KeyOf(b));
+                 });
+      other.ResetRoot();
+      Root() = nullptr;
+      size_ = 0;
+      BuildBalanced(nodes);
+    }
+  }
+
+  /// @brief Разбиение по ключу: элементы не меньше key переносятся в right,
+  /// остальные остаются. Дерево режется спуском к key, а куски по пути
+  /// склеиваются соединением (Join3) по чёрной высоте (по высоте для AVL),
+  /// поэтому перестройка стоит O(log n) без выделения памяти и без
+  /// перемещения элементов. Но размеры частей без SubtreeRank, а отпечаток
+  /// (HashFingerprint) всегда считаются обходом меньшей из частей за
+  /// O(min(k, n - k)), поэтому для частых разбиений нужен SubtreeRank без
+  /// отпечатка. Фильтр не перестраивается: текущее дерево сохраняет
+  /// прежний (лишние ключи дают только ложные срабатывания, перенесённые
+  /// учитываются как удалённые), а у right фильтра нет до первой вставки.
+  /// Буфер записи и лениво удалённые узлы вливаются и убираются заранее.
+  /// Если узлы принадлежат арене дерева, элементы переносятся по одному.
+  /// @param right Пустое дерево, получает настройки текущего.
+  void Split(const key_type& key, RBTree& right) {
+    if (this == &right) {
+      return;
+    }
+    Flush();
+    Compact();
+    right.Clear();
+    right.lt_ = lt_;
+    right.lazy_threshold_ = lazy_threshold_;
+    right.pending_capacity_ = pending_capacity_;
+    if (size_ == 0) {
+      return;
+    }
+    if constexpr (!allocator_type::kShared) {
+      Node* finger = nullptr;
+      for (iterator it = Lower_Bound(key); it != End();) {
+        iterator pos = it++;
+        Node* node = right.AdoptNode(*this, ExtractNode(pos));
+        right.InsertFromFinger(node, finger, false);
+      }
+    } else {
+      Node* root = Root();
+      Root() = nullptr;
+      Piece less{nullptr, 0};
+      Piece greater{nullptr, 0};
+      SplitSubTree({root, JoinHeight(root)}, key, less, greater);
+      size_type total = size_;
+      AttachRoot(less.root);
+      right.AttachRoot(greater.root);
+      if constexpr (kRank && !fingerprint_type::enabled) {
+        size_ = RankCountOf(less.root);
+      } else {
+        // обход меньшей части: обе части обходятся по очереди, пока одна не
+        // кончится
+        fingerprint_type fingerprint = fingerprint_, mine, theirs;
+        size_type count = 0;
+        Node* a = less.root ? Minimum() : header_;
+        Node* b = greater.root ? right.Minimum() : right.header_;
+        for (; a != header_ && b != right.header_; ++count) {
+          mine.Add(KeyOf(a));
+          theirs.Add(KeyOf(b));
+          a = a->NextNode();
+          b = b->NextNode();
+        }
+        size_ = a == header_ ? count : total - count;
+        if (a == header_) {
+          fingerprint_ = mine;
+          fingerprint.Subtract(mine);
+          right.fingerprint_ = fingerprint;
+        } else {
+          right.fingerprint_ = theirs;
+          fingerprint.Subtract(theirs);
+          fingerprint_ = fingerprint;
+        }
+      }
+      right.size_ = total - size_;
+      filter_.Remove(right.size_);
+    }
+  }
+
+  /// @brief Присоединение дерева, все элементы которого больше элементов
+  /// текущего (для uniq == false - не меньше), за O(log n) без выделения
+  /// памяти: наименьший узел other становится средним узлом Join3. Буфер
+  /// записи и лениво удалённые узлы обоих деревьев вливаются и убираются
+  /// заранее. Фильтр не перестраивается, а освобождается (пропускает все
+  /// ключи) и строится заново при следующей вставке. Если узлы принадлежат
+  /// арене дерева, выполняется MergeMulti.
+  /// @return false, если диапазоны ключей пересекаются (деревья не
+  /// меняются).
+  bool Join(RBTree& other, bool uniq) {
+    if (this == &other) {
+      return Size() == 0;
+    }
+    Flush();
+    other.Flush();
+    Compact();
+    other.Compact();
+    if (size_ > 0 && other.size_ > 0) {
+      const key_type& last = KeyOf(Maximum());
+      const key_type& first = KeyOf(other.Minimum());
+      if (uniq ? !Less(last, first) : Less(first, last)) {
+        return false;
+      }
+    }
+    if (other.size_ == 0) {
+      return true;
+    }
+    if constexpr (!allocator_type::kShared) {
+      MergeMulti(other);
+    } else {
+      Node* mid = other.ExtractNode(other.Begin());
+      fingerprint_.Add(KeyOf(mid));
+      fingerprint_.Merge(other.fingerprint_);
+      size_type size = size_ + other.size_ + 1;
+      Node* left = Root();
+      Node* right = other.Root();
+      Root() = nullptr;
+      other.ResetRoot();
+      Piece res = Join3({left, JoinHeight(left)}, mid,
+                        {right, JoinHeight(right)});
+      AttachRoot(res.root);
+      size_ = size;
+      filter_.Clear();
+    }
+    return true;
   }
 
   /// @brief Обмен содержимым двух деревьев.
@@ -270,6 +808,16 @@ class RBTree {
     std::swap(header_, other.header_);
     std::swap(size_, other.size_);
     std::swap(lt_, other.lt_);
+    std::swap(stats_, other.stats_);
+    std::swap(dead_, other.dead_);
+    std::swap(lazy_threshold_, other.lazy_threshold_);
+    std::swap(fingerprint_, other.fingerprint_);
+    std::swap(filter_, other.filter_);
+    std::swap(alloc_, other.alloc_);
+    std::swap(pending_, other.pending_);
+    std::swap(pending_capacity_, other.pending_capacity_);
+    std::swap(pending_uniq_, other.pending_uniq_);
+    std::swap(pending_runs_, other.pending_runs_);
   }
 
   /// @brief Чёрная высота дерева.
@@ -280,14 +828,162 @@ class RBTree {
     return Height(node);
   }
 
+  /// @brief Разбиение элементов на не более чем k поддиапазонов примерно
+  /// равного размера. Границами служат узлы верхних уровней дерева, которые
+  /// делят сбалансированное дерево на части почти одинакового размера, поэтому
+  /// разбиение строится за O(k) без обхода элементов.
+  /// @param k Желаемое количество диапазонов.
+  /// @return Непустые диапазоны [first, second) по порядку, покрывающие все
+  /// элементы.
+  std::vector<std::pair<iterator, iterator>> SplitRanges(size_type k) {
+    std::vector<std::pair<iterator, iterator>> res;
+    if (Size() == 0) {
+      return res;
+    }
+    std::vector<Node*> top;
+    if (k > 1) {
+      // на диапазон приходится около 16 частей, так что перекос отдельных
+      // поддеревьев усредняется
+      int depth = 0;
+      while ((size_type{2} << depth) < 16 * k && depth < 40) ++depth;
+      CollectTop(Root(), depth, top);
+    }
+    Node* first = SkipDead(Minimum());
+    size_type pieces = top.size() + 1;
+    for (size_type j = 1; j < k; ++j) {
+      if (j * pieces / k == 0) continue;
+      Node* bound = SkipDead(top[j * pieces / k - 1]);
+      if (bound == first || bound == header_) continue;
+      res.emplace_back(iterator(first), iterator(bound));
+      first = bound;
+    }
+    res.emplace_back(iterator(first), End());
+    return res;
+  }
+
+  /// @brief Параллельный вызов func для каждого элемента. Элементы делятся
+  /// на диапазоны SplitRanges, каждый обходится в своём потоке. Дерево не
+  /// должно изменяться во время обхода. Первое исключение из func
+  /// пробрасывается после завершения всех потоков.
+  /// @param func Функция от ссылки на элемент.
+  /// @param threads Количество потоков, 0 - по числу ядер.
+  template <typename Func>
+  void ParallelForEach(Func func, unsigned threads = 0) {
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto ranges = SplitRanges(threads);
+    std::vector<std::exception_ptr> errors(ranges.size());
+    auto run = [&](size_type i) {
+      try {
+        for (iterator it = ranges[i].first; it != ranges[i].second; ++it) {
+          func(*it);
+        }
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> workers;
+    for (size_type i = 1; i < ranges.size(); ++i) workers.emplace_back(run, i);
+    if (!ranges.empty()) run(0);
+    for (auto& worker : workers) worker.join();
+    for (auto& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  }
+
+  /// @brief Проверка инвариантов балансировки: для красно-чёрного дерева -
+  /// цвета и чёрная высота, для AVL - высоты поддеревьев.
+  bool IsBalanced() const {
+    if constexpr (kAVL) {
+      return CheckAVL(Root()) != -1 && CheckRank(Root());
+    } else {
+      return (Root() == nullptr || !Root()->red_) &&
+             CheckRedBlack(Root()) != -1 && CheckRank(Root());
+    }
+  }
+
+  /// @brief Средняя глубина узла (корень имеет глубину 1), обход за O(n).
+  double AverageDepth() const {
+    if (size_ == 0) {
+      return 0;
+    }
+    return static_cast<double>(DepthSum(Root(), 1)) / size_;
+  }
+
   /// @brief Содержит ли дерево элемент с заданным ключом.
   /// @param key Ключ по которому производится поиск.
   /// @return true, если элемент найден, иначе false.
   bool Contains(const key_type& key) const {
+    if (PendingContains(key)) {
+      return true;
+    }
+    if (!filter_.MayContain(key)) {
+      stats_.FilterNegative();
+      return false;
+    }
     Node* tmp = nullptr;
-    return !Find(key, Root(), &tmp);
+    bool found = !Find(key, Root(), &tmp) && LiveMatch(tmp, key) != header_;
+    if (!found && filter_type::enabled) {
+      stats_.FilterFalsePositive();
+    }
+    return found;
+  }
+
+  /// @brief k-й по порядку элемент (с нуля) за O(log n). Требует
+  /// TreeOptions::rank_policy = SubtreeRank.
+  /// @return Итератор на элемент или End(), если k >= Size().
+  iterator Select(size_type k) {
+    static_assert(kRank, "s21::RBTree::Select requires SubtreeRank");
+    Node* node = Root();
+    while (node != nullptr) {
+      size_type left = RankCountOf(node->left_);
+      if (k < left) {
+        node = node->left_;
+      } else if (k == left && !node->dead_) {
+        return iterator(node);
+      } else {
+        k -= left + !node->dead_;
+        node = node->right_;
+      }
+    }
+    return End();
+  }
+
+  /// @brief Количество элементов меньше ключа за O(log n). Требует
+  /// TreeOptions::rank_policy = SubtreeRank.
+  size_type Rank(const key_type& key) const {
+    static_assert(kRank, "s21::RBTree::Rank requires SubtreeRank");
+    size_type res = 0;
+    Node* node = Root();
+    while (node != nullptr) {
+      if (Less(KeyOf(node), key)) {
+        res += RankCountOf(node->left_) + !node->dead_;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
+    }
+    return res;
   }
 
+  /// @brief Отпечаток содержимого, не зависящий от порядка вставки (0, если
+  /// TreeOptions::fingerprint_policy - NoFingerprint). Учитываются только
+  /// ключи: значения map могут меняться через итератор.
+  std::uint64_t Fingerprint() const noexcept { return fingerprint_.Value(); }
+
+  /// @brief Снимок статистики дерева. Без политики TreeStats все счётчики
+  /// нулевые.
+  TreeStatsSnapshot Stats() const noexcept {
+    TreeStatsSnapshot res = stats_.Snapshot();
+    res.nodes = size_;
+    res.dead = dead_;
+    return res;
+  }
+
+  /// @brief Обнуление статистики дерева.
+  void ResetStats() noexcept { stats_.Reset(); }
+
   /// @brief Вывод дерева в консоль.
   void PrintTree() {
     int level = 0;
@@ -304,12 +1000,33 @@ class RBTree {
 
   /// @brief Очистка дерева.
   void Clear() {
+    if constexpr (allocator_type::kShared ||
+                  !std::is_trivially_destructible_v<value_type>) {
+      DeleteSubTree(Root());
+    }
+    alloc_.Release();
+    ResetRoot();
+  }
+
+ private:
+  /// @brief Удаление всех узлов без возврата памяти арены: используется,
+  /// когда новые узлы уже выделены из той же арены.
+  void DropNodes() {
     DeleteSubTree(Root());
+    ResetRoot();
+  }
+
+  /// @brief Сброс дерева в пустое состояние (узлы уже удалены).
+  void ResetRoot() {
     Root() = nullptr;
     size_ = 0;
+    dead_ = 0;
+    pending_.clear();
+    pending_runs_.clear();
+    fingerprint_.Reset();
+    filter_.Clear();
   }
 
- private:
   /// @brief Корень дерева
   Node*& Root() { return header_->parent_; }
 
@@ -319,20 +1036,218 @@ class RBTree {
   /// @brief Копирование дерева.
   /// @param other Дерево, которое копируется.
   void CopyTree(const RBTree& other) {
+    lazy_threshold_ = other.lazy_threshold_;
     if (other.Size() == 0) {
       return;
     }
+    if (other.dead_ > 0) {  // помеченные узлы не копируются
+      lt_ = other.lt_;
+      AssignSorted(other.Begin(), other.End(), false);
+      return;
+    }
     Node* other_copy_root = CopyNodes(other.Root(), nullptr);
-    Clear();
+    DropNodes();
     Root() = other_copy_root;
     Root()->parent_ = header_;
     size_ = other.size_;
     lt_ = other.lt_;
+    fingerprint_ = other.fingerprint_;
+    RebuildFilter();
+  }
+
+  /// @brief Копирование буфера записи (дерево уже скопировано).
+  void CopyPending(const RBTree& other) {
+    pending_capacity_ = other.pending_capacity_;
+    pending_uniq_ = other.pending_uniq_;
+    if constexpr (kBufferable) {
+      pending_ = other.pending_;
+      pending_runs_ = other.pending_runs_;
+    }
+  }
+
+  /// @brief Слияние последних серий буфера записи: равных по длине или,
+  /// если all, всех в одну. Слияние устойчивое, более ранняя серия лежит
+  /// левее, поэтому равные ключи сохраняют порядок вставки.
+  void MergePendingRuns(bool all) {
+    auto less = [this](const value_type& a, const value_type& b) {
+      return Less(key_policy::Get(a), key_policy::Get(b));
+    };
+    for (size_type n = pending_runs_.size(); n > 1; --n) {
+      size_type first = n > 2 ? pending_runs_[n - 3] : 0;
+      size_type mid = pending_runs_[n - 2];
+      size_type last = pending_runs_[n - 1];
+      if (!all && mid - first > last - mid) break;
+      std::inplace_merge(pending_.begin() + first, pending_.begin() + mid,
+                         pending_.begin() + last, less);
+      pending_runs_.erase(pending_runs_.end() - 2);
+    }
+  }
+
+  /// @brief Есть ли ключ в буфере записи (двоичный поиск по каждой серии).
+  bool PendingContains(const key_type& key) const {
+    if constexpr (kBufferable) {
+      auto first = pending_.begin();
+      for (size_type end : pending_runs_) {
+        auto last = pending_.begin() + end;
+        auto it = std::lower_bound(
+            first, last, key,
+            [this](const value_type& value, const key_type& k) {
+              return Less(key_policy::Get(value), k);
+            });
+        if (it != last && !Less(key, key_policy::Get(*it))) return true;
+        first = last;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Вставка отсортированного буфера от пальца.
+  void FlushFromFinger() {
+    Node* finger = nullptr;
+    size_type done = 0;
+    try {
+      for (; done < pending_.size(); ++done) {
+        Node* node = NewNode(std::move(pending_[done]));
+        InsertFromFinger(node, finger, pending_uniq_);
+      }
+    } catch (...) {
+      pending_.erase(pending_.begin(), pending_.begin() + done);
+      pending_runs_.assign(1, pending_.size());
+      throw;
+    }
+    pending_.clear();
+    pending_runs_.clear();
+  }
+
+  /// @brief Слияние отсортированного буфера с узлами дерева и сборка.
+  void FlushLinear() {
+    Compact();
+    std::vector<Node*> fresh;
+    std::vector<Node*> nodes;
+    fresh.reserve(pending_.size());
+    nodes.reserve(size_ + pending_.size());
+    try {
+      for (auto& value : pending_) fresh.push_back(NewNode(std::move(value)));
+    } catch (...) {
+      for (size_type i = 0; i < fresh.size(); ++i) {
+        pending_[i] = std::move(fresh[i]->key_);
+        DeleteNode(fresh[i]);
+      }
+      throw;
+    }
+    pending_.clear();
+    pending_runs_.clear();
+    Node* tree_node = size_ > 0 ? Minimum() : header_;
+    for (Node* node : fresh) {
+      for (; tree_node != header_ && !Less(KeyOf(node), KeyOf(tree_node));
+           tree_node = tree_node->NextNode()) {
+        nodes.push_back(tree_node);
+      }
+      if (pending_uniq_ && !nodes.empty() &&
+          !Less(KeyOf(nodes.back()), KeyOf(node))) {
+        DeleteNode(node);
+        continue;
+      }
+      nodes.push_back(node);
+    }
+    for (; tree_node != header_; tree_node = tree_node->NextNode()) {
+      nodes.push_back(tree_node);
+    }
+    Root() = nullptr;
+    size_ = 0;
+    BuildBalanced(nodes);
+  }
+
+  /// @brief Первый непомеченный узел, начиная с данного.
+  static Node* SkipDead(Node* node) noexcept {
+    while (node->dead_) node = node->NextNode();
+    return node;
+  }
+
+  /// @brief Непомеченный узел с ключом, равным ключу найденного узла. Если
+  /// найденный узел удалён лениво, равный ему ищется среди соседей (в
+  /// мультимножестве таких может быть несколько).
+  /// @return Узел или заголовок, если такого нет.
+  Node* LiveMatch(Node* node, const key_type& key) const {
+    if (!node->dead_) {
+      return node;
+    }
+    while (node->PrevNode() != header_ && !Less(KeyOf(node->PrevNode()), key)) {
+      node = node->PrevNode();
+    }
+    for (; node != header_ && !Less(key, KeyOf(node));
+         node = node->NextNode()) {
+      if (!node->dead_) return node;
+    }
+    return header_;
+  }
+
+  /// @brief Сборка сбалансированного дерева из упорядоченных узлов за O(n).
+  /// Узлы самого нижнего уровня красные, остальные черные, поэтому чёрная
+  /// высота всех путей одинакова.
+  /// @param nodes Узлы в порядке возрастания ключей, дерево должно быть пустым.
+  void BuildBalanced(const std::vector<Node*>& nodes) {
+    if (nodes.empty()) {
+      return;
+    }
+    int red_depth = 0;
+    for (size_type n = nodes.size(); n > 1; n >>= 1) {
+      ++red_depth;
+    }
+    Root() = BuildSubTree(nodes, 0, nodes.size(), 0, red_depth);
+    Root()->parent_ = header_;
+    Root()->red_ = false;
+    size_ = nodes.size();
+    fingerprint_.Reset();
+    for (Node* node : nodes) fingerprint_.Add(KeyOf(node));
+    RebuildFilter();
+  }
+
+  /// @brief Перестройка фильтра по живым ключам за O(n). Если памяти не
+  /// хватило, фильтр освобождается и пропускает все ключи до следующей
+  /// вставки.
+  void RebuildFilter() noexcept {
+    if constexpr (filter_type::enabled) {
+      try {
+        filter_.Reset(Size());
+      } catch (const std::bad_alloc&) {
+        filter_.Clear();
+        return;
+      }
+      if (size_ == 0) {
+        return;
+      }
+      for (Node* node = Minimum(); node != header_; node = node->NextNode()) {
+        if (!node->dead_) filter_.Add(KeyOf(node));
+      }
+    }
+  }
+
+  /// @brief Рекурсивная сборка поддерева из узлов [begin, end).
+  /// @return Корень собранного поддерева.
+  Node* BuildSubTree(const std::vector<Node*>& nodes, size_type begin,
+                     size_type end, int depth, int red_depth) {
+    if (begin == end) {
+      return nullptr;
+    }
+    size_type mid = begin + (end - begin) / 2;
+    Node* node = nodes[mid];
+    node->InitNode();
+    node->red_ = depth == red_depth;
+    node->left_ = BuildSubTree(nodes, begin, mid, depth + 1, red_depth);
+    node->right_ = BuildSubTree(nodes, mid + 1, end, depth + 1, red_depth);
+    if (node->left_) node->left_->parent_ = node;
+    if (node->right_) node->right_->parent_ = node;
+    AVLUpdate(node);
+    RankUpdate(node);
+    return node;
   }
 
   Node* CopyNodes(const Node* node, Node* parent) {
-    Node* copy = new Node{node->key_};
+    Node* copy = NewNode(node->key_);
     copy->red_ = node->red_;
+    copy->height_ = node->height_;
+    if constexpr (kRank) copy->count_ = node->count_;
     try {
       if (node->left_) copy->left_ = CopyNodes(node->left_, copy);
       if (node->right_) copy->right_ = CopyNodes(node->right_, copy);
@@ -352,7 +1267,76 @@ class RBTree {
     }
     DeleteSubTree(node->left_);
     DeleteSubTree(node->right_);
-    delete node;
+    DeleteNode(node);
+  }
+
+  /// @brief Создание узла с учётом статистики.
+  template <typename... Args>
+  Node* NewNode(Args&&... args) {
+    void* mem = alloc_.Allocate(sizeof(Node));
+    Node* node = nullptr;
+    try {
+      node = new (mem) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      alloc_.Deallocate(mem, sizeof(Node));
+      throw;
+    }
+    stats_.Allocation();
+    return node;
+  }
+
+  /// @brief Удаление узла с учётом статистики.
+  void DeleteNode(Node* node) noexcept {
+    stats_.Deallocation();
+    node->key_.~value_type();
+    node->~Node();
+    alloc_.Deallocate(node, sizeof(Node));
+  }
+
+  /// @brief Перенос узла другого дерева в своё. Если узлы принадлежат арене
+  /// дерева (TreeOptions::allocation_policy), элемент перемещается в новый
+  /// узел, а старый возвращается арене other.
+  Node* AdoptNode(RBTree& other, Node* node) {
+    if constexpr (allocator_type::kShared) {
+      return node;
+    } else {
+      Node* copy = NewNode(std::move(node->key_));
+      other.DeleteNode(node);
+      return copy;
+    }
+  }
+
+  /// @brief Ключ элемента узла (см. TreeOptions::key_policy).
+  static const key_type& KeyOf(const Node* node) noexcept {
+    return key_policy::Get(node->key_);
+  }
+
+  /// @brief Сравнение ключей с учётом статистики.
+  bool Less(const key_type& left, const key_type& right) const {
+    stats_.Comparison();
+    return lt_(left, right);
+  }
+
+  /// @brief Трёхстороннее сравнение ключей с учётом статистики. Компаратор с
+  /// методом compare(), арифметические ключи и ключи с методом compare() при
+  /// std::less сравниваются один раз, остальные - не более двух раз.
+  /// @return Отрицательное число, если left < right, ноль, если ключи равны,
+  /// иначе положительное число.
+  int ThreeWay(const key_type& left, const key_type& right) const {
+    stats_.Comparison();
+    if constexpr (HasThreeWayCompare<Compare, key_type>::value) {
+      return lt_.compare(left, right);
+    } else if constexpr (std::is_same_v<Compare, std::less<key_type>> &&
+                         std::is_arithmetic_v<key_type>) {
+      return static_cast<int>(right < left) - static_cast<int>(left < right);
+    } else if constexpr (std::is_same_v<Compare, std::less<key_type>> &&
+                         HasKeyCompare<key_type>::value) {
+      return left.compare(right);
+    } else {
+      if (lt_(left, right)) return -1;
+      stats_.Comparison();
+      return lt_(right, left) ? 1 : 0;
+    }
   }
 
   /// @brief Поиск элемента по ключу.
@@ -365,20 +1349,19 @@ class RBTree {
     int ret = -1;
     Node* curNode = start;
     Node* parNode = header_;
+    int depth = 0;
     while (curNode != nullptr) {
-      if (lt_(key, curNode->key_)) {
-        parNode = curNode;
-        curNode = curNode->left_;
-        ret = -1;
-      } else if (lt_(curNode->key_, key)) {
-        parNode = curNode;
-        curNode = curNode->right_;
-        ret = 1;
-      } else {
+      ++depth;
+      int cmp = ThreeWay(key, KeyOf(curNode));
+      if (cmp == 0) {
         ret = 0;
         break;
       }
+      parNode = curNode;
+      ret = cmp < 0 ? -1 : 1;
+      curNode = cmp < 0 ? curNode->left_ : curNode->right_;
     }
+    stats_.Descent(depth);
     *node = parNode;
     if (ret == 0) {
       *node = curNode;
@@ -386,6 +1369,212 @@ class RBTree {
     return ret;
   }
 
+  /// @brief Поиск места вставки после всех равных ключей за один спуск.
+  /// @param key Вставляемый ключ.
+  /// @param start Узел, от которого начинается спуск.
+  /// @param node Указатель, в который записывается будущий родитель.
+  /// @return -1, если ключ вставляется левым сыном, иначе 1.
+  int FindUpper(const key_type& key, Node* start, Node** node) const {
+    int ret = -1;
+    Node* curNode = start;
+    Node* parNode = header_;
+    int depth = 0;
+    while (curNode != nullptr) {
+      ++depth;
+      parNode = curNode;
+      if (Less(key, KeyOf(curNode))) {
+        curNode = curNode->left_;
+        ret = -1;
+      } else {
+        curNode = curNode->right_;
+        ret = 1;
+      }
+    }
+    stats_.Descent(depth);
+    *node = parNode;
+    return ret;
+  }
+
+  /// @brief Используется ли балансировка AVL.
+  static constexpr bool kAVL = std::is_same_v<balance_type, AVLBalance>;
+  /// @brief Буфер записи вливается слиянием за O(n + b), если он не меньше
+  /// n / kLinearFlushRatio, иначе вставкой от пальца.
+  static constexpr size_type kLinearFlushRatio = 4;
+  /// @brief Можно ли хранить элементы в буфере записи (сортировка требует
+  /// присваивания, у пар словаря ключ константный).
+  static constexpr bool kBufferable = std::is_move_assignable_v<value_type>;
+  /// @brief Хранят ли узлы размеры поддеревьев.
+  static constexpr bool kRank = std::is_same_v<rank_type, SubtreeRank>;
+
+  /// @brief Число живых узлов поддерева (0 для пустого).
+  static size_type RankCountOf(const Node* node) noexcept {
+    return node ? node->count_ : 0;
+  }
+
+  /// @brief Пересчёт размера поддерева узла по детям.
+  static void RankUpdate(Node* node) noexcept {
+    if constexpr (kRank) {
+      node->count_ =
+          RankCountOf(node->left_) + RankCountOf(node->right_) + !node->dead_;
+    }
+  }
+
+  /// @brief Пересчёт размеров от узла до корня за O(log n).
+  void RankUpdatePath(Node* node) noexcept {
+    if constexpr (kRank) {
+      for (; node != header_; node = node->parent_) RankUpdate(node);
+    }
+  }
+
+  /// @brief Проверка красно-чёрных инвариантов поддерева.
+  /// @return Чёрная высота поддерева или -1 при нарушении.
+  int CheckRedBlack(const Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    if (node->red_ && ((node->left_ && node->left_->red_) ||
+                       (node->right_ && node->right_->red_))) {
+      return -1;
+    }
+    int left = CheckRedBlack(node->left_);
+    int right = CheckRedBlack(node->right_);
+    if (left == -1 || left != right) {
+      return -1;
+    }
+    return left + (node->red_ ? 0 : 1);
+  }
+
+  /// @brief Проверка размеров поддеревьев порядковой статистики.
+  bool CheckRank(const Node* node) const {
+    if constexpr (kRank) {
+      return node == nullptr ||
+             (CheckRank(node->left_) && CheckRank(node->right_) &&
+              node->count_ == RankCountOf(node->left_) +
+                                  RankCountOf(node->right_) + !node->dead_);
+    } else {
+      return true;
+    }
+  }
+
+  /// @brief Проверка AVL-инвариантов поддерева.
+  /// @return Высота поддерева или -1 при нарушении.
+  int CheckAVL(const Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    int left = CheckAVL(node->left_);
+    int right = CheckAVL(node->right_);
+    if (left == -1 || right == -1 || left - right > 1 || right - left > 1 ||
+        node->height_ != 1 + std::max(left, right)) {
+      return -1;
+    }
+    return node->height_;
+  }
+
+  /// @brief Узлы верхних depth + 1 уровней поддерева в порядке возрастания.
+  static void CollectTop(Node* node, int depth, std::vector<Node*>& out) {
+    if (node == nullptr) {
+      return;
+    }
+    if (depth > 0) CollectTop(node->left_, depth - 1, out);
+    out.push_back(node);
+    if (depth > 0) CollectTop(node->right_, depth - 1, out);
+  }
+
+  /// @brief Сумма глубин узлов поддерева.
+  size_type DepthSum(const Node* node, size_type depth) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    return depth + DepthSum(node->left_, depth + 1) +
+           DepthSum(node->right_, depth + 1);
+  }
+
+  /// @brief Высота поддерева AVL (0 для пустого).
+  static int AVLHeight(const Node* node) noexcept {
+    return node ? node->height_ : 0;
+  }
+
+  /// @brief Пересчёт высоты узла AVL по детям.
+  static void AVLUpdate(Node* node) noexcept {
+    node->height_ = static_cast<unsigned char>(
+        1 + std::max(AVLHeight(node->left_), AVLHeight(node->right_)));
+  }
+
+  /// @brief Балансировка одного узла AVL одинарным или двойным поворотом.
+  /// @return Новый корень поддерева.
+  Node* AVLBalanceNode(Node* node) {
+    int balance = AVLHeight(node->left_) - AVLHeight(node->right_);
+    if (balance > 1) {
+      Node* left = node->left_;
+      if (AVLHeight(left->left_) < AVLHeight(left->right_)) {
+        RotateLeft(left);
+        AVLUpdate(left);
+      }
+      RotateRight(node);
+    } else if (balance < -1) {
+      Node* right = node->right_;
+      if (AVLHeight(right->right_) < AVLHeight(right->left_)) {
+        RotateRight(right);
+        AVLUpdate(right);
+      }
+      RotateLeft(node);
+    }
+    AVLUpdate(node);
+    if (balance > 1 || balance < -1) {
+      node = node->parent_;
+      AVLUpdate(node);
+    }
+    return node;
+  }
+
+  /// @brief Восстановление AVL-инвариантов от узла к корню. Подъём
+  /// прекращается, как только высота очередного поддерева не изменилась.
+  /// @param node Нижний узел, высота которого могла измениться.
+  /// @param insert true после вставки, false после извлечения (для
+  /// статистики).
+  void AVLRebalance(Node* node, bool insert) {
+    while (node != header_) {
+      if (insert) {
+        stats_.InsertFixupStep();
+      } else {
+        stats_.ExtractFixupStep();
+      }
+      int old_height = node->height_;
+      Node* top = AVLBalanceNode(node);
+      if (top->height_ == old_height) {
+        break;
+      }
+      node = top->parent_;
+    }
+  }
+
+  /// @brief Извлечение узла из дерева AVL.
+  /// @param node Извлекаемый узел.
+  /// @return Извлеченный узел.
+  Node* AVLExtractNode(Node* node) {
+    if (node->left_ != nullptr && node->right_ != nullptr) {
+      SwapNodes(node, SearchMin(node->right_));
+    }
+    Node* child = node->left_ ? node->left_ : node->right_;
+    Node* parent = node->parent_;
+    if (child != nullptr) {
+      child->parent_ = parent;
+    }
+    if (node == Root()) {
+      Root() = child;
+    } else if (parent->left_ == node) {
+      parent->left_ = child;
+    } else {
+      parent->right_ = child;
+    }
+    RankUpdatePath(parent);
+    AVLRebalance(parent, false);
+    --size_;
+    node->InitNode();
+    return node;
+  }
+
   /// @brief Чёрная высота, рассчитываемая от узла.
   /// @param node Узел, от которого производится расчет.
   /// @return Количество чёрных узлов от узла до листа, если дерево
@@ -427,6 +1616,8 @@ class RBTree {
     std::swap(node->left_, other->left_);
     std::swap(node->right_, other->right_);
     std::swap(node->red_, other->red_);
+    std::swap(node->height_, other->height_);
+    if constexpr (kRank) std::swap(node->count_, other->count_);
 
     // меняем родительские ссылки у детей
     if (node->left_) node->left_->parent_ = node;
@@ -442,6 +1633,7 @@ class RBTree {
     Node* parent = del->parent_;
     while (del != Root() &&
            del->red_ == false) {  // пока узел черный и не корень
+      stats_.ExtractFixupStep();
       if (del == parent->left_) {  // если узел левый сын
         Node* brother = parent->right_;
         if (brother->red_) {  // если брат красный
@@ -523,6 +1715,11 @@ class RBTree {
       return nullptr;
     }
     Node* node = pos.node_;
+    fingerprint_.Remove(KeyOf(node));
+    filter_.Remove();
+    if constexpr (kAVL) {
+      return AVLExtractNode(node);
+    }
     // если у удаляемого узла два сына, то меняем его с преемником, т.к.
     // преемник всегда будет иметь не более одного сына и удаляем преемника
     if (node->left_ != nullptr && node->right_ != nullptr) {
@@ -539,6 +1736,12 @@ class RBTree {
     // если узел красный и у него один сын, то дерево несбалансировано
     // красный узел без детей можно просто удалить
 
+    // узел стал листом: поддеревья предков больше его не учитывают, а
+    // повороты балансировки пересчитывают размеры сами
+    if constexpr (kRank) {
+      node->count_ = 0;
+      RankUpdatePath(node->parent_);
+    }
     // если узел черный и у него нет детей, то нужна балансировка
     if (node->red_ == false && node->left_ == nullptr &&
         node->right_ == nullptr) {
@@ -567,18 +1770,53 @@ class RBTree {
   /// элемент и true, иначе итератор на элемент с таким ключом и false.
   std::pair<iterator, bool> InsertNode(Node* newNode, bool uniq) {
     Node* parNode = nullptr;
-    int ret = Find(newNode->key_, Root(), &parNode);
-    while (ret == 0) {
-      if (uniq) return {iterator(parNode), false};
-      Node* start = parNode->right_;
-      if (start) {
-        parNode = nullptr;
-        ret = Find(newNode->key_, start, &parNode);
-      } else {
-        break;
+    int ret = 0;
+    if (uniq) {
+      ret = Find(KeyOf(newNode), Root(), &parNode);
+      if (ret == 0 && parNode->dead_) {
+        ReplaceNode(parNode, newNode);
+        return {iterator(newNode), true};
       }
+      if (ret == 0) return {iterator(parNode), false};
+    } else {
+      ret = FindUpper(KeyOf(newNode), Root(), &parNode);
     }
+    LinkNode(newNode, parNode, ret);
+    return {iterator(newNode), true};
+  }
 
+  /// @brief Замена лениво удалённого узла новым узлом с равным ключом на
+  /// том же месте, без балансировки.
+  void ReplaceNode(Node* dead, Node* newNode) {
+    newNode->parent_ = dead->parent_;
+    newNode->left_ = dead->left_;
+    newNode->right_ = dead->right_;
+    newNode->red_ = dead->red_;
+    newNode->height_ = dead->height_;
+    if constexpr (kRank) newNode->count_ = dead->count_;
+    if (dead == Root()) {
+      Root() = newNode;
+    } else if (dead->parent_->left_ == dead) {
+      dead->parent_->left_ = newNode;
+    } else {
+      dead->parent_->right_ = newNode;
+    }
+    if (newNode->left_) newNode->left_->parent_ = newNode;
+    if (newNode->right_) newNode->right_->parent_ = newNode;
+    RankUpdatePath(newNode);
+    --dead_;
+    fingerprint_.Add(KeyOf(newNode));
+    filter_.Add(KeyOf(newNode));
+    DeleteNode(dead);
+    if (filter_.NeedsRebuild()) RebuildFilter();
+  }
+
+  /// @brief Подвешивание узла к найденному родителю и балансировка.
+  /// @param newNode Узел, который нужно вставить.
+  /// @param parNode Родитель, найденный поиском.
+  /// @param ret -1, если узел становится левым сыном, иначе 1.
+  void LinkNode(Node* newNode, Node* parNode, int ret) {
+    fingerprint_.Add(KeyOf(newNode));
     if (!size_) {
       Root() = newNode;
       newNode->parent_ = header_;
@@ -590,15 +1828,108 @@ class RBTree {
       } else {
         parNode->right_ = newNode;
       }
+      RankUpdatePath(parNode);
     }
     InsertFixup(newNode);
     ++size_;
+    filter_.Add(KeyOf(newNode));
+    if (filter_.NeedsRebuild()) RebuildFilter();
+  }
+
+  /// @brief Вставка узла упорядоченного пакета: место ищется от пальца.
+  /// @param finger Узел предыдущего ключа, заменяется узлом этого ключа.
+  /// @param uniq Флаг, запрещающий одинаковые ключи: узел с повтором
+  /// удаляется.
+  std::pair<iterator, bool> InsertFromFinger(Node* newNode, Node*& finger,
+                                             bool uniq) {
+    Node* equal = nullptr;
+    Node* start = ClimbFromFinger(KeyOf(newNode), finger, !uniq, &equal);
+    Node* parNode = header_;
+    int ret = -1;
+    if (equal == nullptr && start != nullptr) {
+      ret = uniq ? Find(KeyOf(newNode), start, &parNode)
+                 : FindUpper(KeyOf(newNode), start, &parNode);
+      if (ret == 0) equal = parNode;
+    }
+    if (equal != nullptr && equal->dead_) {
+      ReplaceNode(equal, newNode);
+      finger = newNode;
+      return {iterator(newNode), true};
+    }
+    if (equal != nullptr) {
+      DeleteNode(newNode);
+      finger = equal;
+      return {iterator(equal), false};
+    }
+    LinkNode(newNode, parNode, ret);
+    finger = newNode;
     return {iterator(newNode), true};
   }
 
+  /// @brief Подъём от пальца (узла предыдущего ключа пакета) к наименьшему
+  /// поддереву, в котором лежит место очередного ключа. Подъём идёт по
+  /// ссылкам на родителя и заканчивается на первом предке, для которого
+  /// поддерево оказалось левым и ключ меньше предка, поэтому стоит O(log d),
+  /// где d - расстояние между соседними ключами пакета.
+  /// @param key Очередной ключ пакета.
+  /// @param finger Узел предыдущего ключа или nullptr.
+  /// @param upper true, если равные ключи нужно обходить справа (вставка с
+  /// повторами).
+  /// @param equal Сюда записывается узел с равным ключом, встреченный при
+  /// подъёме, иначе nullptr.
+  /// @return Узел, от которого нужно продолжить спуск (nullptr для пустого
+  /// дерева).
+  Node* ClimbFromFinger(const key_type& key, Node* finger, bool upper,
+                        Node** equal) const {
+    *equal = nullptr;
+    if (finger == nullptr || finger == header_) {
+      return Root();
+    }
+    int cmp = ThreeWay(key, KeyOf(finger));
+    if (cmp < 0) {  // пакет не упорядочен - обычный спуск от корня
+      return Root();
+    }
+    if (cmp == 0 && !upper) {
+      *equal = finger;
+      return finger;
+    }
+    Node* node = finger;
+    while (node != Root()) {
+      Node* parent = node->parent_;
+      if (node == parent->left_) {
+        cmp = ThreeWay(key, KeyOf(parent));
+        if (cmp < 0) break;
+        if (cmp == 0 && !upper) {
+          *equal = parent;
+          break;
+        }
+      }
+      node = parent;
+    }
+    return node;
+  }
+
+  /// @brief Поиск ключа пакета от пальца.
+  /// @param key Ключ.
+  /// @param finger Палец, заменяется последним посещённым узлом.
+  /// @return Узел с ключом или nullptr.
+  Node* FingerFind(const key_type& key, Node*& finger) const {
+    Node* equal = nullptr;
+    Node* start = ClimbFromFinger(key, finger, false, &equal);
+    if (equal != nullptr || start == nullptr) {
+      finger = equal;
+      return equal;
+    }
+    Node* node = nullptr;
+    int ret = Find(key, start, &node);
+    finger = node;
+    return ret == 0 ? node : nullptr;
+  }
+
   /// @brief Поворот влево.
   /// @param node Узел, от которого производится поворот.
   void RotateLeft(Node* node) {
+    stats_.Rotation();
     Node* rightNode = node->right_;
     rightNode->parent_ = node->parent_;
     if (node == Root()) {
@@ -614,11 +1945,14 @@ class RBTree {
     }
     node->parent_ = rightNode;
     rightNode->left_ = node;
+    RankUpdate(node);
+    RankUpdate(rightNode);
   }
 
   /// @brief Поворот вправо.
   /// @param node Узел, от которого производится поворот.
   void RotateRight(Node* node) {
+    stats_.Rotation();
     Node* leftNode = node->left_;
     leftNode->parent_ = node->parent_;
     if (node == Root()) {
@@ -634,12 +1968,135 @@ class RBTree {
     }
     node->parent_ = leftNode;
     leftNode->right_ = node;
+    RankUpdate(node);
+    RankUpdate(leftNode);
+  }
+
+  /// @brief Поддерево, отсоединённое от дерева, и его высота для Join3.
+  struct Piece {
+    Node* root;
+    /// @brief Чёрная высота с учётом корня или высота AVL.
+    int height;
+  };
+
+  /// @brief Высота поддерева для соединения: чёрная высота с учётом корня
+  /// (по левому краю) или высота AVL.
+  int JoinHeight(const Node* node) const noexcept {
+    if constexpr (kAVL) {
+      return AVLHeight(node);
+    } else {
+      int height = 0;
+      for (; node != nullptr; node = node->left_) height += !node->red_;
+      return height;
+    }
+  }
+
+  /// @brief Подвешивание отсоединённого поддерева корнем дерева.
+  void AttachRoot(Node* root) noexcept {
+    Root() = root;
+    if (root != nullptr) {
+      root->parent_ = header_;
+      root->red_ = false;
+    }
+  }
+
+  /// @brief Разбиение отсоединённого поддерева на части меньше key и не
+  /// меньше key. Узел каждого уровня склеивается со своим поддеревом с
+  /// другой стороны и частью, пришедшей снизу; высоты склеиваемых частей
+  /// растут снизу вверх, поэтому стоимости Join3 складываются в O(log n).
+  void SplitSubTree(Piece tree, const key_type& key, Piece& less,
+                    Piece& greater) {
+    Node* node = tree.root;
+    if (node == nullptr) {
+      less = greater = Piece{nullptr, 0};
+      return;
+    }
+    // чёрная высота сына не зависит от его цвета
+    int child_height = tree.height - !node->red_;
+    Piece left{node->left_, kAVL ? AVLHeight(node->left_) : child_height};
+    Piece right{node->right_, kAVL ? AVLHeight(node->right_) : child_height};
+    Piece rest{nullptr, 0};
+    if (Less(KeyOf(node), key)) {
+      SplitSubTree(right, key, rest, greater);
+      less = Join3(left, node, rest);
+    } else {
+      SplitSubTree(left, key, less, rest);
+      greater = Join3(rest, node, right);
+    }
+  }
+
+  /// @brief Соединение отсоединённых поддеревьев left и right через узел
+  /// mid (ключи left <= mid <= right) за O(|разность высот| + 1): mid
+  /// подвешивается на краю более высокого поддерева к узлу на уровне
+  /// низкого, и дерево балансируется как после вставки. На время
+  /// балансировки высокое поддерево подвешивается к заголовку, поэтому
+  /// корень дерева должен быть отсоединён.
+  /// @return Корень и высота результата.
+  Piece Join3(Piece left, Node* mid, Piece right) {
+    mid->InitNode();
+    if constexpr (!kAVL) {  // у красного корня растёт чёрная высота
+      if (left.root && left.root->red_) {
+        left.root->red_ = false;
+        ++left.height;
+      }
+      if (right.root && right.root->red_) {
+        right.root->red_ = false;
+        ++right.height;
+      }
+    }
+    int diff = left.height - right.height;
+    if (kAVL ? diff <= 1 && diff >= -1 : diff == 0) {
+      mid->left_ = left.root;
+      mid->right_ = right.root;
+      if (left.root) left.root->parent_ = mid;
+      if (right.root) right.root->parent_ = mid;
+      mid->red_ = false;
+      AVLUpdate(mid);
+      RankUpdate(mid);
+      return {mid, kAVL ? AVLHeight(mid) : left.height + 1};
+    }
+    bool on_right = diff > 0;
+    Piece& tall = on_right ? left : right;
+    Piece& low = on_right ? right : left;
+    Root() = tall.root;
+    tall.root->parent_ = header_;
+    // спуск по краю высокого поддерева до узла на уровне низкого: чёрного
+    // с той же чёрной высотой или AVL-узла не выше low.height + 1
+    Node* parent = header_;
+    Node* node = tall.root;
+    int height = tall.height;
+    while (node != nullptr && (kAVL ? AVLHeight(node) > low.height + 1
+                                    : node->red_ || height > low.height)) {
+      height -= !node->red_;
+      parent = node;
+      node = on_right ? node->right_ : node->left_;
+    }
+    (on_right ? parent->right_ : parent->left_) = mid;
+    (on_right ? mid->left_ : mid->right_) = node;
+    (on_right ? mid->right_ : mid->left_) = low.root;
+    mid->parent_ = parent;
+    if (node) node->parent_ = mid;
+    if (low.root) low.root->parent_ = mid;
+    AVLUpdate(mid);
+    RankUpdate(mid);
+    RankUpdatePath(parent);
+    bool grown = InsertFixup(mid);
+    Piece res{Root(), kAVL ? AVLHeight(Root()) : tall.height + grown};
+    Root() = nullptr;
+    return res;
   }
 
   /// @brief Балансировка дерева после вставки.
   /// @param node Узел, от которого производится балансировка.
-  void InsertFixup(Node* node) {
+  /// @return true, если красный корень перекрашен в чёрный (чёрная высота
+  /// дерева выросла).
+  bool InsertFixup(Node* node) {
+    if constexpr (kAVL) {
+      AVLRebalance(node->parent_, true);
+      return false;
+    }
     while (node != Root() && node->parent_->red_) {  // пока родитель красный
+      stats_.InsertFixupStep();
       if (node->parent_ ==
           node->parent_->parent_->left_) {  // если родитель левый сын
         Node* uncleNode = node->parent_->parent_->right_;  // uncleNode - дядя
@@ -676,9 +2133,11 @@ class RBTree {
         }
       }
     }
-    if (node == Root()) {  // корень всегда черный
+    if (node == Root() && node->red_) {  // корень всегда черный
       node->red_ = false;
+      return true;
     }
+    return false;
   }
 
   /// @brief Минимальный элемент в дереве.
@@ -719,39 +2178,63 @@ class RBTree {
     return node;
   }
 
-  struct Node {
-    /// @brief Конструктор по умолчанию.
+  struct Node : RankCount<kRank> {
+    /// @brief Конструктор по умолчанию. Используется только для заголовка,
+    /// ключ не создаётся, поэтому ключу не нужен конструктор по умолчанию.
     Node()
         : parent_(nullptr),
           left_(nullptr),
           right_(nullptr),
           red_(true),
-          key_(key_type{}) {}
+          height_(1),
+          dead_(false) {}
+
+    /// @brief Деструктор. Ключ разрушается в RBTree::DeleteNode.
+    ~Node() {}
 
     /// @brief Конструктор с параметром.
     /// @param key Ключ, который будет записан в узел.
-    Node(const key_type& key)
+    Node(const value_type& key)
         : parent_(nullptr),
           left_(nullptr),
           right_(nullptr),
           red_(true),
+          height_(1),
+          dead_(false),
           key_(key) {}
 
     /// @brief Конструктор с параметром, перемещающий ключ.
     /// @param key Ключ, который будет записан в узел.
-    Node(const key_type&& key)
+    Node(value_type&& key)
         : parent_(nullptr),
           left_(nullptr),
           right_(nullptr),
           red_(true),
+          height_(1),
+          dead_(false),
           key_(std::move(key)) {}
 
+    /// @brief Конструктор, создающий ключ на месте.
+    /// @param args Аргументы конструктора ключа.
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args&&... args)
+        : parent_(nullptr),
+          left_(nullptr),
+          right_(nullptr),
+          red_(true),
+          height_(1),
+          dead_(false),
+          key_(std::forward<Args>(args)...) {}
+
     /// @brief Приведение узла к виду по умолчанию.
     void InitNode() {
       parent_ = nullptr;
       left_ = nullptr;
       right_ = nullptr;
       red_ = true;
+      height_ = 1;
+      dead_ = false;
+      this->ResetCount();
     }
 
     /// @brief Следующий узел.
@@ -794,7 +2277,13 @@ class RBTree {
     Node* left_;
     Node* right_;
     bool red_;
-    key_type key_;
+    /// @brief Высота поддерева, используется балансировкой AVL.
+    unsigned char height_;
+    /// @brief Узел удалён лениво и пропускается итераторами и поиском.
+    bool dead_;
+    union {
+      value_type key_;
+    };
   };
 
   /// @brief Итератор.
@@ -814,29 +2303,36 @@ class RBTree {
     /// @brief Указатель на значение узла.
     reference operator*() const { return node_->key_; }
 
+    /// @brief Доступ к полям элемента.
+    pointer operator->() const { return &node_->key_; }
+
     /// @brief Префиксный инкремент.
     Iterator& operator++() {
-      node_ = node_->NextNode();
+      do {
+        node_ = node_->NextNode();
+      } while (node_->dead_);
       return *this;
     }
 
     /// @brief Постфиксный инкремент.
     Iterator operator++(int) {
       Iterator tmp = *this;
-      node_ = node_->NextNode();
+      ++*this;
       return tmp;
     }
 
     /// @brief Префиксный декремент.
     Iterator& operator--() {
-      node_ = node_->PrevNode();
+      do {
+        node_ = node_->PrevNode();
+      } while (node_->dead_);
       return *this;
     }
 
     /// @brief Постфиксный декремент.
     Iterator operator--(int) {
       Iterator tmp = *this;
-      node_ = node_->PrevNode();
+      --*this;
       return tmp;
     }
 
@@ -877,27 +2373,37 @@ class RBTree {
 
     ConstIterator() = delete;
     explicit ConstIterator(Node* node) : node_(node) {}
+
+    /// @brief Преобразование из обычного итератора, как у контейнеров STL.
+    ConstIterator(const Iterator& it) : node_(it.node_) {}
     reference operator*() const { return node_->key_; }
 
+    /// @brief Доступ к полям элемента.
+    pointer operator->() const { return &node_->key_; }
+
     ConstIterator& operator++() {
-      node_ = node_->NextNode();
+      do {
+        node_ = node_->NextNode();
+      } while (node_->dead_);
       return *this;
     }
 
     ConstIterator operator++(int) {
       ConstIterator tmp = *this;
-      node_ = node_->NextNode();
+      ++*this;
       return tmp;
     }
 
     ConstIterator& operator--() {
-      node_ = node_->PrevNode();
+      do {
+        node_ = node_->PrevNode();
+      } while (node_->dead_);
       return *this;
     }
 
     ConstIterator operator--(int) {
       ConstIterator tmp = *this;
-      node_ = node_->PrevNode();
+      --*this;
       return tmp;
     }
 
@@ -928,6 +2434,24 @@ class RBTree {
   Node* header_;
   size_type size_;
   Compare lt_;
+  mutable stats_type stats_;
+  /// @brief Количество лениво удалённых узлов.
+  size_type dead_;
+  /// @brief Порог доли удалённых узлов, 0 - ленивое удаление выключено.
+  double lazy_threshold_;
+  /// @brief Отпечаток ключей живых элементов.
+  fingerprint_type fingerprint_;
+  /// @brief Размещение узлов.
+  allocator_type alloc_;
+  /// @brief Фильтр живых ключей перед поиском.
+  filter_type filter_;
+  /// @brief Буфер записи: элементы, ещё не вставленные в дерево.
+  std::vector<value_type> pending_;
+  /// @brief Концы отсортированных серий буфера, длины серий убывают.
+  std::vector<size_type> pending_runs_;
+  bool pending_uniq_ = false;
+  /// @brief Размер буфера записи, 0 - буфер выключен.
+  size_type pending_capacity_ = 0;
 };
 
 }  // namespace s21
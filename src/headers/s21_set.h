@@ -1,20 +1,24 @@
 #ifndef S21_SET_H_
 #define S21_SET_H_
 
+#include <stdexcept>
+
 #include "s21_rbtree.h"
 
 namespace s21 {
 
-template <typename Key, typename Compare = std::less<Key>>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
 class set {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = RBTree<key_type, Compare>;
-  using iterator = typename RBTree<key_type, Compare>::iterator;
-  using const_iterator = typename RBTree<key_type, Compare>::const_iterator;
+  using key_compare = Compare;
+  using tree_type = RBTree<key_type, Compare, Options>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
 
   /// @brief Конструктор по умолчанию.
@@ -55,10 +59,10 @@ class set {
   ~set() { delete tree_; }
 
   /// @brief Возвращает итератор на первый элемент.
-  iterator begin() { return tree_->Begin(); }
+  iterator begin() { return Tree()->Begin(); }
 
   /// @brief Возвращает итератор на первый элемент.
-  const_iterator begin() const { return tree_->Begin(); }
+  const_iterator begin() const { return Tree()->Begin(); }
 
   /// @brief Возвращает итератор на элемент, следующий за последним.
   iterator end() { return tree_->End(); }
@@ -67,11 +71,11 @@ class set {
   const_iterator end() const { return tree_->End(); }
 
   /// @brief Возвращает количество элементов в контейнере.
-  size_type size() const { return tree_->Size(); }
+  size_type size() const { return Tree()->Size(); }
 
   /// @brief Проверяет, пустой ли контейнер.
   /// @return true, если контейнер пустой, иначе false.
-  bool empty() const { return tree_->Size() == 0; }
+  bool empty() const { return Tree()->Size() == 0; }
 
   /// @brief Максимальное количество элементов, которое может хранить контейнер.
   size_type max_size() const { return tree_->Max_Size(); }
@@ -83,7 +87,22 @@ class set {
   /// @param value Значение, которое будет вставлено в контейнер.
   /// @return Указатель на вставленный элемент и флаг успешности вставки.
   std::pair<iterator, bool> insert(const value_type &value) {
-    return tree_->InsertKey(value, true);
+    return Tree()->InsertKey(value, true);
+  }
+
+  /// @brief Вставка элемента в контейнер с перемещением.
+  /// @param value Значение, которое будет перемещено в контейнер.
+  /// @return Указатель на вставленный элемент и флаг успешности вставки.
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return Tree()->InsertKey(std::move(value), true);
+  }
+
+  /// @brief Вставка элемента, создаваемого прямо в узле дерева.
+  /// @param args Аргументы конструктора элемента.
+  /// @return Указатель на вставленный элемент и флаг успешности вставки.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return Tree()->Emplace(true, std::forward<Args>(args)...);
   }
 
   /// @brief Удаляет элемент из контейнера по позиции.
@@ -93,32 +112,165 @@ class set {
   void swap(set &other) { tree_->Swap(*other.tree_); }
 
   /// @brief Слияние двух контейнеров.
-  void merge(set &other) { tree_->Merge(*other.tree_); }
+  void merge(set &other) { Tree()->Merge(*other.Tree()); }
+
+  /// @brief Разбиение по ключу без выделения памяти под узлы (см.
+  /// RBTree::Split): в контейнере остаются элементы меньше key. Дерево
+  /// режется за O(log n), но размер частей считается обходом меньшей из
+  /// них за O(min(k, n - k)), если в Options нет SubtreeRank, и всегда при
+  /// HashFingerprint: для частых разбиений нужен rank_policy = SubtreeRank.
+  /// Фильтр не перестраивается (у результата его нет до первой вставки).
+  /// @return Контейнер с элементами не меньше key.
+  set split(const key_type &key) {
+    set res;
+    tree_->Split(key, *res.tree_);
+    return res;
+  }
+
+  /// @brief Присоединение контейнера, все элементы которого больше
+  /// элементов текущего, за O(log n) без выделения памяти (см.
+  /// RBTree::Join). other становится пустым. Фильтр не перестраивается
+  /// сразу, а строится заново при следующей вставке.
+  /// @throw std::invalid_argument, если диапазоны элементов пересекаются.
+  void join(set &other) {
+    if (!tree_->Join(*other.tree_, true)) {
+      throw std::invalid_argument("s21::set::join: ranges overlap");
+    }
+  }
 
   /// @brief Поиск элемента по значению.
   /// @param key Искомое значение.
   /// @return Указатель на элемент, если он найден, иначе nullptr.
-  iterator find(const key_type &key) { return tree_->Find(key); }
+  iterator find(const key_type &key) { return Tree()->Find(key); }
 
   /// @brief Проверяет, содержится ли элемент в контейнере.
   bool contains(const key_type &key) { return tree_->Contains(key); }
 
-  void print() { tree_->PrintTree(); }
+  /// @brief Возвращает итератор на первый элемент, который не меньше заданного.
+  iterator lower_bound(const key_type &key) { return Tree()->Lower_Bound(key); }
+
+  /// @brief Возвращает итератор на первый элемент, который больше заданного.
+  iterator upper_bound(const key_type &key) { return Tree()->Upper_Bound(key); }
+
+  /// @brief Включение буфера записи для пакетов вставок (см.
+  /// RBTree::SetWriteBuffer): insert_buffered не спускается по дереву, а
+  /// буфер вливается одним проходом, когда заполнен или перед чтением.
+  /// Чтения, в том числе константные (size, empty, begin, fingerprint,
+  /// contains_sorted_batch), вливают непустой буфер, то есть меняют
+  /// дерево: перед чтением из нескольких потоков нужно вызвать flush().
+  /// После этого константные члены ничего не пишут.
+  /// @param capacity Размер буфера, 0 - выключить.
+  void set_write_buffer(size_type capacity) {
+    tree_->SetWriteBuffer(capacity);
+  }
+
+  /// @brief Вставка через буфер записи. Итератор не возвращается: элемент
+  /// попадает в дерево при вливании.
+  void insert_buffered(const value_type &value) {
+    tree_->InsertBuffered(value, true);
+  }
+
+  /// @brief Вставка через буфер записи с перемещением.
+  void insert_buffered(value_type &&value) {
+    tree_->InsertBuffered(std::move(value), true);
+  }
+
+  /// @brief Немедленное вливание буфера записи.
+  void flush() { tree_->Flush(); }
+
+  void print() { Tree()->PrintTree(); }
 
   bool operator==(const set &other) const {
-    return tree_->operator==(*other.tree_);
+    return Tree()->operator==(*other.Tree());
   }
 
   bool operator!=(const set &other) const {
-    return tree_->operator!=(*other.tree_);
+    return Tree()->operator!=(*other.Tree());
+  }
+
+  /// @brief Поиск упорядоченного пакета ключей: каждый поиск продолжается от
+  /// элемента, найденного для предыдущего ключа.
+  /// @param first Начало диапазона ключей, упорядоченных по Compare.
+  /// @param last Конец диапазона.
+  /// @return Итераторы на найденные элементы или end().
+  template <typename InputIt>
+  std::vector<iterator> find_sorted_batch(InputIt first, InputIt last) {
+    return Tree()->FindSortedBatch(first, last);
+  }
+
+  /// @brief Проверка наличия упорядоченного пакета ключей.
+  /// @param first Начало диапазона ключей, упорядоченных по Compare.
+  /// @param last Конец диапазона.
+  /// @return Для каждого ключа true, если он есть в контейнере.
+  template <typename InputIt>
+  std::vector<bool> contains_sorted_batch(InputIt first, InputIt last) const {
+    return Tree()->ContainsSortedBatch(first, last);
+  }
+
+  /// @brief Вставка упорядоченного пакета элементов: место каждого ищется от
+  /// предыдущего вставленного.
+  /// @param first Начало диапазона, упорядоченного по Compare.
+  /// @param last Конец диапазона.
+  template <typename InputIt>
+  std::vector<std::pair<iterator, bool>> insert_sorted_batch(InputIt first,
+                                                             InputIt last) {
+    return Tree()->InsertSortedBatch(first, last, true);
+  }
+
+  /// @brief Заменяет содержимое контейнера отсортированным диапазоном за O(n).
+  /// @param first Начало диапазона, упорядоченного по Compare.
+  /// @param last Конец диапазона.
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_->AssignSorted(first, last, true);
+  }
+
+  /// @brief Снимок статистики горячего пути (см. TreeOptions::stats_policy).
+  TreeStatsSnapshot stats() const noexcept { return tree_->Stats(); }
+
+  /// @brief Обнуление статистики.
+  void reset_stats() noexcept { tree_->ResetStats(); }
+
+  /// @brief Отпечаток содержимого для ключей кэша и быстрого operator!= (см.
+  /// TreeOptions::fingerprint_policy).
+  std::uint64_t fingerprint() const { return Tree()->Fingerprint(); }
+
+  /// @brief Разбиение на не более чем k непустых поддиапазонов примерно
+  /// равного размера за O(k), например для параллельной обработки.
+  std::vector<std::pair<iterator, iterator>> split_ranges(size_type k) {
+    return Tree()->SplitRanges(k);
+  }
+
+  /// @brief Параллельный вызов func для каждого элемента (см.
+  /// RBTree::ParallelForEach). Контейнер не должен изменяться во время обхода.
+  /// @param threads Количество потоков, 0 - по числу ядер.
+  template <typename Func>
+  void parallel_for_each(Func func, unsigned threads = 0) {
+    Tree()->ParallelForEach(func, threads);
   }
 
+  /// @brief Ленивое удаление: erase только помечает элемент, а дерево
+  /// перестраивается за O(n), когда доля помеченных превышает порог.
+  /// @param threshold Порог из (0, 1], 0 - обычное удаление.
+  void set_lazy_erase(double threshold) { tree_->SetLazyErase(threshold); }
+
+  /// @brief Немедленное удаление помеченных элементов.
+  void compact() { tree_->Compact(); }
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
-    return tree_->Insert_Many(std::forward<Args>(args)...);
+    return Tree()->Insert_Many(std::forward<Args>(args)...);
   }
 
  private:
+  /// @brief Дерево с влитым буфером записи: все операции, кроме вставок
+  /// через буфер и contains, видят вставленные через буфер элементы.
+  /// Вливание меняет дерево и в константных членах (см. set_write_buffer).
+  tree_type *Tree() const {
+    tree_->Flush();
+    return tree_;
+  }
+
   tree_type *tree_;
 };
 
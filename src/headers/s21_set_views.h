@@ -0,0 +1,274 @@
+#ifndef S21_SET_VIEWS_H_
+#define S21_SET_VIEWS_H_
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/// @brief Операция ленивого представления над двумя упорядоченными
+/// источниками. Для мультимножеств кратности считаются как в std::set_union
+/// и т.д.: объединение - максимум, пересечение - минимум, разность - a - b,
+/// слияние - сумма.
+enum class SetOperation { kUnion, kIntersection, kDifference, kMerge };
+
+template <typename A, typename B, SetOperation Op>
+class set_view;
+
+/// @brief Является ли тип ленивым представлением.
+template <typename T>
+struct IsSetView : std::false_type {};
+
+template <typename A, typename B, SetOperation Op>
+struct IsSetView<set_view<A, B, Op>> : std::true_type {};
+
+/// @brief Возвращает ли разыменование итератора ссылку.
+template <typename It>
+struct IsLvalueDeref
+    : std::is_lvalue_reference<decltype(*std::declval<const It &>())> {};
+
+/// @brief Ленивое представление результата операции над двумя
+/// упорядоченными источниками (set, multiset или другим представлением).
+/// Элементы вычисляются при обходе слиянием итераторов источников, ничего не
+/// выделяется. Контейнеры хранятся по указателю и должны жить дольше
+/// представления, вложенные представления копируются. Источники не должны
+/// изменяться во время обхода.
+template <typename A, typename B, SetOperation Op>
+class set_view {
+ public:
+  using key_type = typename A::key_type;
+  using value_type = typename A::key_type;
+  using key_compare = typename A::key_compare;
+  using size_type = std::size_t;
+
+  static_assert(std::is_same_v<key_type, typename B::key_type>,
+                "s21::set_view: sources must have the same key type");
+
+  /// @brief Итератор представления (однонаправленный).
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = set_view::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    /// @brief Ссылка, если оба источника отдают ссылки, иначе значение
+    /// (например, у bitmap_set).
+    using reference =
+        std::conditional_t<IsLvalueDeref<typename A::iterator>::value &&
+                               IsLvalueDeref<typename B::iterator>::value,
+                           const value_type &, value_type>;
+
+    reference operator*() const { return from_b_ ? *b_ : *a_; }
+    pointer operator->() const { return &**this; }
+
+    iterator &operator++() {
+      if constexpr (Op == SetOperation::kUnion) {
+        if (both_) {
+          ++a_;
+          ++b_;
+        } else if (from_b_) {
+          ++b_;
+        } else {
+          ++a_;
+        }
+      } else if constexpr (Op == SetOperation::kIntersection) {
+        ++a_;
+        ++b_;
+      } else if constexpr (Op == SetOperation::kDifference) {
+        ++a_;
+      } else {
+        if (from_b_) {
+          ++b_;
+        } else {
+          ++a_;
+        }
+      }
+      Settle();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const {
+      return a_ == other.a_ && b_ == other.b_;
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class set_view;
+
+    /// @brief Сколько шагов делать итератором, прежде чем искать позицию
+    /// через lower_bound источника за O(log n).
+    static constexpr int kLinearSteps = 8;
+
+    iterator(const set_view *view, typename A::iterator a,
+             typename B::iterator b)
+        : view_(view),
+          a_(a),
+          a_end_(view->a_.get().end()),
+          b_(b),
+          b_end_(view->b_.get().end()) {
+      Settle();
+    }
+
+    bool Less(const value_type &left, const value_type &right) const {
+      return view_->comp_(left, right);
+    }
+
+    /// @brief Продвижение it до первого элемента не меньше key: сначала
+    /// несколько шагов, затем спуск в источнике (galloping), поэтому
+    /// пересечение с разреженным источником не обходит плотный целиком.
+    template <typename Source, typename It>
+    void SkipTo(Source &source, It &it, const It &end, const value_type &key) {
+      for (int i = 0; i < kLinearSteps; ++i) {
+        if (it == end || !Less(*it, key)) return;
+        ++it;
+      }
+      if (it != end && Less(*it, key)) it = source.lower_bound(key);
+    }
+
+    /// @brief Переход к ближайшему элементу результата.
+    void Settle() {
+      both_ = from_b_ = false;
+      if constexpr (Op == SetOperation::kIntersection) {
+        while (a_ != a_end_ && b_ != b_end_) {
+          if (Less(*a_, *b_)) {
+            SkipTo(view_->a_.get(), a_, a_end_, *b_);
+          } else if (Less(*b_, *a_)) {
+            SkipTo(view_->b_.get(), b_, b_end_, *a_);
+          } else {
+            return;
+          }
+        }
+        a_ = a_end_;
+        b_ = b_end_;
+      } else if constexpr (Op == SetOperation::kDifference) {
+        while (a_ != a_end_ && b_ != b_end_) {
+          if (Less(*a_, *b_)) {
+            return;
+          } else if (Less(*b_, *a_)) {
+            SkipTo(view_->b_.get(), b_, b_end_, *a_);
+          } else {
+            ++a_;
+            ++b_;
+          }
+        }
+        if (a_ == a_end_) b_ = b_end_;
+      } else {
+        if (b_ == b_end_) return;
+        if (a_ == a_end_ || Less(*b_, *a_)) {
+          from_b_ = true;
+        } else if (Op == SetOperation::kUnion && !Less(*a_, *b_)) {
+          both_ = true;
+        }
+      }
+    }
+
+    const set_view *view_;
+    typename A::iterator a_, a_end_;
+    typename B::iterator b_, b_end_;
+    /// @brief Текущий элемент берётся из b.
+    bool from_b_ = false;
+    /// @brief Текущие элементы a и b равны (только для объединения).
+    bool both_ = false;
+  };
+
+  using const_iterator = iterator;
+
+  /// @brief Конструктор представления над источниками a и b.
+  template <typename SA, typename SB>
+  set_view(SA &&a, SB &&b)
+      : a_(std::forward<SA>(a)), b_(std::forward<SB>(b)) {}
+
+  iterator begin() const {
+    return iterator(this, a_.get().begin(), b_.get().begin());
+  }
+
+  iterator end() const {
+    return iterator(this, a_.get().end(), b_.get().end());
+  }
+
+  /// @brief Первый элемент результата не меньше key за O(log n) в каждом
+  /// источнике. Позволяет вкладывать представления друг в друга.
+  iterator lower_bound(const key_type &key) const {
+    return iterator(this, a_.get().lower_bound(key),
+                    b_.get().lower_bound(key));
+  }
+
+  /// @brief Пусто ли представление (вычисляет первый элемент).
+  bool empty() const { return begin() == end(); }
+
+ private:
+  /// @brief Источник: контейнер по указателю, представление по значению.
+  template <typename T, bool = IsSetView<T>::value>
+  struct Source {
+    explicit Source(T &source) : source_(&source) {}
+    T &get() const { return *source_; }
+    T *source_;
+  };
+
+  template <typename T>
+  struct Source<T, true> {
+    explicit Source(T source) : source_(std::move(source)) {}
+    T &get() const { return source_; }
+    mutable T source_;
+  };
+
+  Source<A> a_;
+  Source<B> b_;
+  key_compare comp_;
+};
+
+namespace views_detail {
+
+template <SetOperation Op, typename A, typename B>
+set_view<std::decay_t<A>, std::decay_t<B>, Op> MakeView(A &&a, B &&b) {
+  static_assert(IsSetView<std::decay_t<A>>::value ||
+                    std::is_lvalue_reference_v<A>,
+                "s21::set_view: a temporary container would dangle");
+  static_assert(IsSetView<std::decay_t<B>>::value ||
+                    std::is_lvalue_reference_v<B>,
+                "s21::set_view: a temporary container would dangle");
+  return {std::forward<A>(a), std::forward<B>(b)};
+}
+
+}  // namespace views_detail
+
+/// @brief Ленивое объединение a и b.
+template <typename A, typename B>
+auto union_view(A &&a, B &&b) {
+  return views_detail::MakeView<SetOperation::kUnion>(std::forward<A>(a),
+                                                      std::forward<B>(b));
+}
+
+/// @brief Ленивое пересечение a и b. Если один источник значительно
+/// разреженнее, позиция в другом ищется через lower_bound.
+template <typename A, typename B>
+auto intersection_view(A &&a, B &&b) {
+  return views_detail::MakeView<SetOperation::kIntersection>(
+      std::forward<A>(a), std::forward<B>(b));
+}
+
+/// @brief Ленивая разность a - b.
+template <typename A, typename B>
+auto difference_view(A &&a, B &&b) {
+  return views_detail::MakeView<SetOperation::kDifference>(std::forward<A>(a),
+                                                           std::forward<B>(b));
+}
+
+/// @brief Ленивое слияние a и b с сохранением всех повторов (для
+/// мультимножеств), равные элементы a идут раньше элементов b.
+template <typename A, typename B>
+auto merge_view(A &&a, B &&b) {
+  return views_detail::MakeView<SetOperation::kMerge>(std::forward<A>(a),
+                                                      std::forward<B>(b));
+}
+
+}  // namespace s21
+
+#endif  // S21_SET_VIEWS_H_
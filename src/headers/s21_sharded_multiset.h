@@ -0,0 +1,142 @@
+#ifndef S21_SHARDED_MULTISET_H_
+#define S21_SHARDED_MULTISET_H_
+
+#include <thread>
+#include <vector>
+
+#include "s21_multiset.h"
+
+namespace s21 {
+
+/// @brief Мультимножество из частных шардов для параллельного наполнения:
+/// каждый поток вставляет в свой шард (shard(index) или insert(index, ...))
+/// без синхронизации. Чтения видят объединённое содержимое: size, count и
+/// contains суммируют шарды без слияния, а упорядоченные операции (begin,
+/// find, lower_bound, upper_bound) сначала сливают шарды в общее дерево
+/// (consolidate) попарно за O(n log k) через multiset::merge_linear.
+/// Чтения и consolidate нельзя выполнять одновременно со вставками.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Options = TreeOptions>
+class sharded_multiset {
+ public:
+  using shard_type = multiset<Key, Compare, Options>;
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using iterator = typename shard_type::iterator;
+  using const_iterator = typename shard_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор.
+  /// @param shards Количество шардов, 0 - по числу ядер.
+  explicit sharded_multiset(size_type shards = 0)
+      : shards_(shards > 0
+                    ? shards
+                    : std::max(1u, std::thread::hardware_concurrency())) {}
+
+  /// @brief Количество шардов.
+  size_type shards() const { return shards_.size(); }
+
+  /// @brief Частный шард потока: вставки в разные шарды можно выполнять
+  /// параллельно.
+  shard_type &shard(size_type index) { return shards_[index].set; }
+
+  /// @brief Вставляет элемент в шард index.
+  iterator insert(size_type index, const value_type &value) {
+    return shards_[index].set.insert(value);
+  }
+
+  /// @brief Вставляет элемент в шард index с перемещением.
+  iterator insert(size_type index, value_type &&value) {
+    return shards_[index].set.insert(std::move(value));
+  }
+
+  /// @brief Слияние всех шардов в общее дерево. Шарды становятся пустыми,
+  /// итераторы на их элементы остаются действительными. Общее дерево не
+  /// обменивается с шардом (обмен переносит и его заголовок), поэтому end()
+  /// остаётся действительным.
+  void consolidate() {
+    for (size_type step = 1; step < shards_.size(); step *= 2) {
+      for (size_type i = 0; i + step < shards_.size(); i += step * 2) {
+        shards_[i].set.merge_linear(shards_[i + step].set);
+      }
+    }
+    merged_.merge_linear(shards_[0].set);
+  }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const { return size() == 0; }
+
+  /// @brief Количество элементов во всех шардах.
+  size_type size() const {
+    size_type res = merged_.size();
+    for (const auto &shard : shards_) res += shard.set.size();
+    return res;
+  }
+
+  /// @brief Очищает контейнер.
+  void clear() {
+    merged_.clear();
+    for (auto &shard : shards_) shard.set.clear();
+  }
+
+  /// @brief Количество элементов с заданным значением во всех шардах.
+  size_type count(const key_type &key) const {
+    size_type res = merged_.count(key);
+    for (const auto &shard : shards_) res += shard.set.count(key);
+    return res;
+  }
+
+  /// @brief Проверяет, есть ли элемент в каком-либо шарде.
+  bool contains(const key_type &key) const {
+    if (merged_.contains(key)) {
+      return true;
+    }
+    for (const auto &shard : shards_) {
+      if (shard.set.contains(key)) return true;
+    }
+    return false;
+  }
+
+  /// @brief Итератор на первый элемент объединённого содержимого.
+  iterator begin() {
+    consolidate();
+    return merged_.begin();
+  }
+
+  /// @brief Итератор за последним элементом объединённого содержимого.
+  iterator end() { return merged_.end(); }
+
+  /// @brief Поиск элемента в объединённом содержимом.
+  iterator find(const key_type &key) {
+    consolidate();
+    return merged_.find(key);
+  }
+
+  /// @brief Первый элемент, не меньший key.
+  iterator lower_bound(const key_type &key) {
+    consolidate();
+    return merged_.lower_bound(key);
+  }
+
+  /// @brief Первый элемент, больший key.
+  iterator upper_bound(const key_type &key) {
+    consolidate();
+    return merged_.upper_bound(key);
+  }
+
+ private:
+  /// @brief Шард на отдельной линии кэша, чтобы потоки не делили строки.
+  struct alignas(64) Shard {
+    shard_type set;
+  };
+
+  std::vector<Shard> shards_;
+  shard_type merged_;
+};
+
+}  // namespace s21
+
+#endif  // S21_SHARDED_MULTISET_H_
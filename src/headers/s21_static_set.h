@@ -0,0 +1,271 @@
+#ifndef S21_STATIC_SET_H_
+#define S21_STATIC_SET_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace s21 {
+
+/// @brief Хэш ключа, вычисляемый при компиляции: целые типы и
+/// std::string_view. Для остальных типов enabled = false.
+template <typename Key, typename = void>
+struct StaticHash {
+  static constexpr bool enabled = false;
+};
+
+/// @brief Финализатор splitmix64.
+constexpr std::uint64_t StaticMix(std::uint64_t x) noexcept {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/// @brief Наименьшая степень двойки, не меньшая n (не меньше 1).
+constexpr std::size_t StaticSlotCount(std::size_t n) noexcept {
+  std::size_t res = 1;
+  while (res < n) res *= 2;
+  return res;
+}
+
+template <typename Key>
+struct StaticHash<Key, std::enable_if_t<std::is_integral_v<Key>>> {
+  static constexpr bool enabled = true;
+  static constexpr std::uint64_t Get(Key key) noexcept {
+    return StaticMix(static_cast<std::uint64_t>(key));
+  }
+};
+
+template <>
+struct StaticHash<std::string_view> {
+  static constexpr bool enabled = true;
+  /// @brief FNV-1a с финализатором.
+  static constexpr std::uint64_t Get(std::string_view key) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : key) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return StaticMix(hash);
+  }
+};
+
+/// @brief Неизменяемое множество, построенное при компиляции из массива
+/// ключей: без инициализации при запуске и без кучи. Ключи хранятся
+/// отсортированными (итерация, find) и в раскладке Эйтцингера (lower_bound,
+/// upper_bound): уровни неявного дерева поиска лежат подряд, поэтому
+/// первые шаги спуска попадают в одни и те же линии кэша. Для целых ключей
+/// и std::string_view с std::less contains и find идут через идеальную
+/// хэш-таблицу (хэширование со смещением по корзинам): один хэш, одно
+/// обращение к таблице и одно сравнение ключа.
+/// Пример: constexpr auto kKeywords =
+///     s21::make_static_set<std::string_view>({"if", "else", "for"});
+/// @tparam N Количество ключей в исходном массиве (повторы отбрасываются).
+template <typename Key, std::size_t N, typename Compare = std::less<Key>>
+class static_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using const_iterator = const value_type *;
+  using iterator = const_iterator;
+
+  /// @brief Используется ли идеальная хэш-таблица для contains и find.
+  static constexpr bool kHashed = StaticHash<Key>::enabled &&
+                                  std::is_same_v<Compare, std::less<Key>>;
+
+  /// @brief Построение из массива ключей (при компиляции в constexpr).
+  constexpr explicit static_set(const Key (&keys)[N]) {
+    for (size_type i = 0; i < N; ++i) keys_[i] = keys[i];
+    // пирамидальная сортировка: std::sort в C++17 не constexpr
+    for (size_type i = N / 2; i > 0; --i) SiftDown(i - 1, N);
+    for (size_type end = N; end > 1; --end) {
+      Key top = keys_[0];
+      keys_[0] = keys_[end - 1];
+      keys_[end - 1] = top;
+      SiftDown(0, end - 1);
+    }
+    for (size_type i = 0; i < N; ++i) {
+      if (size_ == 0 || Compare()(keys_[size_ - 1], keys_[i])) {
+        keys_[size_++] = keys_[i];
+      }
+    }
+    FillEytzinger(0, 1);
+    if constexpr (kHashed) BuildHash();
+  }
+
+  /// @brief Итератор на наименьший ключ.
+  constexpr const_iterator begin() const { return keys_.data(); }
+
+  /// @brief Итератор за наибольшим ключом.
+  constexpr const_iterator end() const { return keys_.data() + size_; }
+
+  /// @brief Проверяет, пустое ли множество.
+  constexpr bool empty() const { return size_ == 0; }
+
+  /// @brief Количество различных ключей.
+  constexpr size_type size() const { return size_; }
+
+  /// @brief Проверяет, содержит ли множество ключ.
+  constexpr bool contains(const key_type &key) const {
+    return find(key) != end();
+  }
+
+  /// @brief Поиск ключа.
+  /// @return Итератор на ключ или end().
+  constexpr const_iterator find(const key_type &key) const {
+    if constexpr (kHashed) {
+      std::uint64_t hash = StaticHash<Key>::Get(key);
+      std::uint32_t index = slots_[Slot(hash, displacement_[Bucket(hash)])];
+      return index != kEmpty && keys_[index] == key ? begin() + index : end();
+    } else {
+      const_iterator it = lower_bound(key);
+      return it != end() && !Compare()(key, *it) ? it : end();
+    }
+  }
+
+  /// @brief Количество ключей, равных key (0 или 1).
+  constexpr size_type count(const key_type &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  /// @brief Первый ключ, не меньший key (спуск по раскладке Эйтцингера).
+  constexpr const_iterator lower_bound(const key_type &key) const {
+    size_type k = 1;
+    while (k <= size_) k = 2 * k + Compare()(eytzinger_[k], key);
+    // убираем повороты направо после последнего поворота налево
+    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+    return k == 0 ? end() : begin() + order_[k];
+  }
+
+  /// @brief Первый ключ, больший key.
+  constexpr const_iterator upper_bound(const key_type &key) const {
+    size_type k = 1;
+    while (k <= size_) k = 2 * k + !Compare()(key, eytzinger_[k]);
+    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+    return k == 0 ? end() : begin() + order_[k];
+  }
+
+ private:
+  static constexpr std::uint32_t kEmpty = ~std::uint32_t(0);
+  /// @brief Корзины по 2 ключа в среднем и таблица с загрузкой не выше 1/2:
+  /// смещение для корзины находится за несколько попыток.
+  static constexpr size_type kBuckets = kHashed ? N / 2 + 1 : 0;
+  static constexpr size_type kSlots = kHashed ? StaticSlotCount(2 * N) : 0;
+  static constexpr std::uint32_t kMaxDisplacement = 1u << 20;
+
+  static constexpr size_type Bucket(std::uint64_t hash) {
+    return static_cast<size_type>((hash >> 32) % kBuckets);
+  }
+
+  static constexpr size_type Slot(std::uint64_t hash, std::uint32_t d) {
+    return static_cast<size_type>(StaticMix(hash + d) & (kSlots - 1));
+  }
+
+  /// @brief Просеивание вниз в max-куче keys_[0, end).
+  constexpr void SiftDown(size_type i, size_type end) {
+    Key key = keys_[i];
+    for (size_type child = 2 * i + 1; child < end; child = 2 * i + 1) {
+      if (child + 1 < end && Compare()(keys_[child], keys_[child + 1])) {
+        ++child;
+      }
+      if (!Compare()(key, keys_[child])) break;
+      keys_[i] = keys_[child];
+      i = child;
+    }
+    keys_[i] = key;
+  }
+
+  /// @brief Раскладка Эйтцингера: обход неявного дерева (дети узла k -
+  /// 2k и 2k + 1) в порядке возрастания заполняет его отсортированными
+  /// ключами.
+  /// @return Номер следующего отсортированного ключа.
+  constexpr size_type FillEytzinger(size_type i, size_type k) {
+    if (k <= size_) {
+      i = FillEytzinger(i, 2 * k);
+      eytzinger_[k] = keys_[i];
+      order_[k] = i++;
+      i = FillEytzinger(i, 2 * k + 1);
+    }
+    return i;
+  }
+
+  /// @brief Построение идеальной хэш-таблицы: корзины обрабатываются от
+  /// больших к меньшим, для каждой подбирается смещение, при котором все
+  /// её ключи попадают в свободные и разные ячейки.
+  constexpr void BuildHash() {
+    std::array<std::uint64_t, N> hashes{};
+    std::array<size_type, kBuckets> sizes{};
+    for (size_type i = 0; i < size_; ++i) {
+      hashes[i] = StaticHash<Key>::Get(keys_[i]);
+      ++sizes[Bucket(hashes[i])];
+    }
+    for (auto &slot : slots_) slot = kEmpty;
+    for (size_type largest = N; largest > 0; --largest) {
+      for (size_type b = 0; b < kBuckets; ++b) {
+        if (sizes[b] == largest) PlaceBucket(b, hashes);
+      }
+    }
+  }
+
+  constexpr void PlaceBucket(size_type b,
+                             const std::array<std::uint64_t, N> &hashes) {
+    for (std::uint32_t d = 0; d < kMaxDisplacement; ++d) {
+      size_type placed = 0;
+      bool ok = true;
+      for (size_type i = 0; i < size_ && ok; ++i) {
+        if (Bucket(hashes[i]) != b) continue;
+        size_type slot = Slot(hashes[i], d);
+        if (slots_[slot] != kEmpty) {
+          ok = false;
+        } else {
+          slots_[slot] = static_cast<std::uint32_t>(i);
+          ++placed;
+        }
+      }
+      if (ok) {
+        displacement_[b] = d;
+        return;
+      }
+      // откат ячеек, занятых этой попыткой
+      for (size_type i = 0; i < size_ && placed > 0; ++i) {
+        if (Bucket(hashes[i]) != b) continue;
+        size_type slot = Slot(hashes[i], d);
+        if (slots_[slot] == i) {
+          slots_[slot] = kEmpty;
+          --placed;
+        }
+      }
+    }
+    throw std::logic_error("s21::static_set: no perfect hash (equal hashes)");
+  }
+
+  std::array<Key, N> keys_{};
+  size_type size_ = 0;
+  /// @brief Узлы неявного дерева с 1, eytzinger_[0] не используется.
+  std::array<Key, N + 1> eytzinger_{};
+  /// @brief Номер ключа узла неявного дерева в keys_.
+  std::array<size_type, N + 1> order_{};
+  std::array<std::uint32_t, kBuckets> displacement_{};
+  std::array<std::uint32_t, kSlots> slots_{};
+};
+
+template <typename Key, std::size_t N>
+static_set(const Key (&)[N]) -> static_set<Key, N>;
+
+/// @brief Построение static_set с явным типом ключа:
+/// make_static_set<std::string_view>({"a", "b"}).
+template <typename Key, typename Compare = std::less<Key>, std::size_t N>
+constexpr static_set<Key, N, Compare> make_static_set(const Key (&keys)[N]) {
+  return static_set<Key, N, Compare>(keys);
+}
+
+}  // namespace s21
+
+#endif  // S21_STATIC_SET_H_
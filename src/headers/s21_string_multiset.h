@@ -0,0 +1,267 @@
+#ifndef S21_STRING_MULTISET_H_
+#define S21_STRING_MULTISET_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "s21_arena.h"
+#include "s21_inline_string.h"
+#include "s21_rbtree.h"
+
+namespace s21 {
+
+/// @brief Мультимножество строк для подсчёта частот: каждой различной строке
+/// соответствует один узел со счётчиком, байты длинных строк интернируются в
+/// арену, принадлежащую контейнеру.
+class string_multiset {
+ public:
+  using key_type = std::string_view;
+  using size_type = std::size_t;
+  /// @brief Строка и количество её вхождений.
+  using value_type = std::pair<std::string_view, size_type>;
+
+ private:
+  /// @brief Ключ узла: строка и счётчик вхождений.
+  struct CountedString {
+    CountedString() = default;
+    CountedString(std::string_view str, size_type count)
+        : key(str), count(count) {}
+    CountedString(InlineString key, size_type count)
+        : key(key), count(count) {}
+
+    bool operator==(const CountedString &other) const {
+      return key == other.key && count == other.count;
+    }
+
+    bool operator!=(const CountedString &other) const {
+      return !(*this == other);
+    }
+
+    InlineString key;
+    size_type count = 0;
+  };
+
+  /// @brief Сравнение только по строке, счётчик в порядке не участвует.
+  struct CountedStringLess {
+    bool operator()(const CountedString &a,
+                    const CountedString &b) const noexcept {
+      return InlineString::Compare(a.key, b.key) < 0;
+    }
+
+    int compare(const CountedString &a, const CountedString &b) const noexcept {
+      return InlineString::Compare(a.key, b.key);
+    }
+  };
+
+ public:
+  using tree_type = RBTree<CountedString, CountedStringLess>;
+
+  /// @brief Итератор по различным строкам в порядке возрастания.
+  class iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = string_multiset::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    /// @brief Строка и количество её вхождений.
+    value_type operator*() const { return {(*it_).key.View(), (*it_).count}; }
+
+    iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    iterator operator++(int) { return iterator(it_++); }
+
+    iterator &operator--() {
+      --it_;
+      return *this;
+    }
+
+    iterator operator--(int) { return iterator(it_--); }
+
+    bool operator==(const iterator &other) const { return it_ == other.it_; }
+
+    bool operator!=(const iterator &other) const { return it_ != other.it_; }
+
+   private:
+    friend class string_multiset;
+    explicit iterator(typename tree_type::iterator it) : it_(it) {}
+
+    typename tree_type::iterator it_;
+  };
+
+  using const_iterator = iterator;
+
+  /// @brief Конструктор по умолчанию.
+  string_multiset() : tree_(new tree_type()), size_(0) {}
+
+  /// @brief Конструктор списка инициализации.
+  string_multiset(std::initializer_list<std::string_view> const &items)
+      : string_multiset() {
+    for (auto item : items) insert(item);
+  }
+
+  /// @brief Конструктор копирования. Байты длинных строк копируются в
+  /// собственную арену; если копирование бросит исключение, скопированное
+  /// дерево удаляется (деструктор недостроенного объекта не вызывается).
+  string_multiset(const string_multiset &other)
+      : tree_(new tree_type(*other.tree_)), size_(other.size_) {
+    try {
+      for (auto it = tree_->Begin(); it != tree_->End(); ++it) {
+        InlineString &key = (*it).key;
+        if (key.IsLong()) key.Rebind(arena_.Store(key.View()));
+      }
+    } catch (...) {
+      delete tree_;
+      throw;
+    }
+  }
+
+  /// @brief Конструктор перемещения.
+  string_multiset(string_multiset &&other) noexcept : string_multiset() {
+    swap(other);
+  }
+
+  /// @brief Оператор присваивания копированием.
+  string_multiset &operator=(const string_multiset &other) {
+    if (this != &other) {
+      string_multiset tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  string_multiset &operator=(string_multiset &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~string_multiset() { delete tree_; }
+
+  /// @brief Возвращает итератор на первую строку.
+  iterator begin() const { return iterator(tree_->Begin()); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() const { return iterator(tree_->End()); }
+
+  /// @brief Общее количество вхождений всех строк.
+  size_type size() const noexcept { return size_; }
+
+  /// @brief Количество различных строк.
+  size_type distinct() const noexcept { return tree_->Size(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// @brief Очищает контейнер и освобождает арену.
+  void clear() noexcept {
+    tree_->Clear();
+    arena_.Clear();
+    size_ = 0;
+  }
+
+  /// @brief Добавляет count вхождений строки за один спуск по дереву. Узел
+  /// выделяется и байты копируются в арену только для новой строки, у
+  /// повторной увеличивается счётчик найденного узла.
+  /// @return Итератор на строку.
+  iterator insert(std::string_view str, size_type count = 1) {
+    auto res = tree_->TryEmplace(
+        Probe(str), StoredInlineString<ByteArena>{str, arena_}, count);
+    if (!res.second) (*res.first).count += count;
+    size_ += count;
+    return iterator(res.first);
+  }
+
+  /// @brief Удаляет одно вхождение строки по итератору.
+  void erase(iterator pos) {
+    if (pos == end()) {
+      return;
+    }
+    --size_;
+    if (--(*pos.it_).count == 0) tree_->Erase(pos.it_);
+  }
+
+  /// @brief Количество вхождений строки.
+  size_type count(std::string_view str) const {
+    auto it = tree_->Find(Probe(str));
+    return it == tree_->End() ? 0 : (*it).count;
+  }
+
+  /// @brief Поиск строки.
+  iterator find(std::string_view str) const {
+    return iterator(tree_->Find(Probe(str)));
+  }
+
+  /// @brief Проверяет, содержится ли строка в контейнере.
+  bool contains(std::string_view str) const {
+    return tree_->Contains(Probe(str));
+  }
+
+  /// @brief Первая строка, не меньшая заданной.
+  iterator lower_bound(std::string_view str) const {
+    return iterator(tree_->Lower_Bound(Probe(str)));
+  }
+
+  /// @brief Первая строка, большая заданной.
+  iterator upper_bound(std::string_view str) const {
+    return iterator(tree_->Upper_Bound(Probe(str)));
+  }
+
+  /// @brief Строки в порядке убывания частоты, при равенстве - по возрастанию.
+  /// @param limit Сколько первых строк вернуть.
+  std::vector<value_type> top(size_type limit) const {
+    std::vector<value_type> res(begin(), end());
+    limit = std::min(limit, res.size());
+    auto by_count = [](const value_type &a, const value_type &b) {
+      return a.second > b.second || (a.second == b.second && a.first < b.first);
+    };
+    std::partial_sort(res.begin(), res.begin() + limit, res.end(), by_count);
+    res.resize(limit);
+    return res;
+  }
+
+  /// @brief Все строки в порядке убывания частоты.
+  std::vector<value_type> by_frequency() const { return top(distinct()); }
+
+  /// @brief Обменивает содержимое с другим контейнером.
+  void swap(string_multiset &other) noexcept {
+    tree_->Swap(*other.tree_);
+    arena_.Swap(other.arena_);
+    std::swap(size_, other.size_);
+  }
+
+  /// @brief Объём арены длинных строк в байтах.
+  size_type arena_bytes() const noexcept { return arena_.Capacity(); }
+
+  bool operator==(const string_multiset &other) const {
+    return size_ == other.size_ && *tree_ == *other.tree_;
+  }
+
+  bool operator!=(const string_multiset &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  /// @brief Ключ поиска, ссылающийся на байты строки без копирования.
+  static CountedString Probe(std::string_view str) { return {str, 0}; }
+
+  tree_type *tree_;
+  ByteArena arena_;
+  size_type size_;
+};
+
+}  // namespace s21
+
+#endif  // S21_STRING_MULTISET_H_
@@ -0,0 +1,191 @@
+#ifndef S21_STRING_SET_H_
+#define S21_STRING_SET_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+#include "s21_arena.h"
+#include "s21_inline_string.h"
+#include "s21_rbtree.h"
+
+namespace s21 {
+
+/// @brief Множество строк с ключами InlineString: короткие строки целиком
+/// лежат в узле, байты длинных строк - в арене, принадлежащей контейнеру.
+class string_set {
+ public:
+  using tree_type = RBTree<InlineString, InlineStringLess>;
+  using key_type = std::string_view;
+  using value_type = std::string_view;
+  using size_type = std::size_t;
+
+  /// @brief Итератор, возвращающий строки как std::string_view.
+  class iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::string_view;
+
+    /// @brief Строка, на которую указывает итератор.
+    std::string_view operator*() const { return (*it_).View(); }
+
+    iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    iterator operator++(int) { return iterator(it_++); }
+
+    iterator &operator--() {
+      --it_;
+      return *this;
+    }
+
+    iterator operator--(int) { return iterator(it_--); }
+
+    bool operator==(const iterator &other) const { return it_ == other.it_; }
+
+    bool operator!=(const iterator &other) const { return it_ != other.it_; }
+
+   private:
+    friend class string_set;
+    explicit iterator(typename tree_type::iterator it) : it_(it) {}
+
+    typename tree_type::iterator it_;
+  };
+
+  using const_iterator = iterator;
+
+  /// @brief Конструктор по умолчанию.
+  string_set() : tree_(new tree_type()) {}
+
+  /// @brief Конструктор списка инициализации.
+  string_set(std::initializer_list<std::string_view> const &items)
+      : string_set() {
+    for (auto item : items) insert(item);
+  }
+
+  /// @brief Конструктор копирования. Байты длинных строк копируются в
+  /// собственную арену; если копирование бросит исключение, скопированное
+  /// дерево удаляется (деструктор недостроенного объекта не вызывается).
+  string_set(const string_set &other) : tree_(new tree_type(*other.tree_)) {
+    try {
+      Rebind();
+    } catch (...) {
+      delete tree_;
+      throw;
+    }
+  }
+
+  /// @brief Конструктор перемещения.
+  string_set(string_set &&other) noexcept : string_set() { swap(other); }
+
+  /// @brief Оператор присваивания копированием.
+  string_set &operator=(const string_set &other) {
+    if (this != &other) {
+      string_set tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  string_set &operator=(string_set &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~string_set() { delete tree_; }
+
+  /// @brief Возвращает итератор на первую строку.
+  iterator begin() const { return iterator(tree_->Begin()); }
+
+  /// @brief Возвращает итератор на элемент, следующий за последним.
+  iterator end() const { return iterator(tree_->End()); }
+
+  /// @brief Количество строк.
+  size_type size() const noexcept { return tree_->Size(); }
+
+  /// @brief Проверяет, пустой ли контейнер.
+  bool empty() const noexcept { return tree_->Size() == 0; }
+
+  /// @brief Очищает контейнер и освобождает арену.
+  void clear() noexcept {
+    tree_->Clear();
+    arena_.Clear();
+  }
+
+  /// @brief Вставка строки. Временные строки не создаются, в арену
+  /// копируются только байты новой длинной строки, до подвешивания узла:
+  /// если копирование бросит исключение, дерево не изменится.
+  /// @return Итератор на строку и флаг успешности вставки.
+  std::pair<iterator, bool> insert(std::string_view str) {
+    auto res = tree_->TryEmplace(InlineString(str),
+                                 StoredInlineString<ByteArena>{str, arena_});
+    return {iterator(res.first), res.second};
+  }
+
+  /// @brief Удаляет строку по итератору. Байты в арене освобождаются только
+  /// при clear().
+  void erase(iterator pos) { tree_->Erase(pos.it_); }
+
+  /// @brief Поиск строки.
+  iterator find(std::string_view str) const {
+    return iterator(tree_->Find(InlineString(str)));
+  }
+
+  /// @brief Проверяет, содержится ли строка в контейнере.
+  bool contains(std::string_view str) const {
+    return tree_->Contains(InlineString(str));
+  }
+
+  /// @brief Первая строка, не меньшая заданной.
+  iterator lower_bound(std::string_view str) const {
+    return iterator(tree_->Lower_Bound(InlineString(str)));
+  }
+
+  /// @brief Первая строка, большая заданной.
+  iterator upper_bound(std::string_view str) const {
+    return iterator(tree_->Upper_Bound(InlineString(str)));
+  }
+
+  /// @brief Обменивает содержимое с другим контейнером.
+  void swap(string_set &other) noexcept {
+    tree_->Swap(*other.tree_);
+    arena_.Swap(other.arena_);
+  }
+
+  /// @brief Объём арены длинных строк в байтах.
+  size_type arena_bytes() const noexcept { return arena_.Capacity(); }
+
+  bool operator==(const string_set &other) const {
+    return *tree_ == *other.tree_;
+  }
+
+  bool operator!=(const string_set &other) const {
+    return *tree_ != *other.tree_;
+  }
+
+ private:
+  /// @brief Копирует байты длинных строк в собственную арену.
+  void Rebind() {
+    for (auto it = tree_->Begin(); it != tree_->End(); ++it) {
+      if ((*it).IsLong()) (*it).Rebind(arena_.Store((*it).View()));
+    }
+  }
+
+  tree_type *tree_;
+  ByteArena arena_;
+};
+
+}  // namespace s21
+
+#endif  // S21_STRING_SET_H_
@@ -0,0 +1,115 @@
+#ifndef S21_TREE_STATS_H_
+#define S21_TREE_STATS_H_
+
+#include <array>
+#include <cstddef>
+
+namespace s21 {
+
+/// @brief Снимок счётчиков дерева.
+struct TreeStatsSnapshot {
+  using size_type = std::size_t;
+
+  /// @brief Максимальная глубина спуска, учитываемая в гистограмме отдельно.
+  static constexpr int kMaxDepth = 63;
+
+  /// @brief Вызовы компаратора.
+  size_type comparisons = 0;
+  /// @brief Повороты в RotateLeft/RotateRight.
+  size_type rotations = 0;
+  /// @brief Итерации цикла InsertFixup.
+  size_type insert_fixup_steps = 0;
+  /// @brief Итерации цикла ExtractFixup.
+  size_type extract_fixup_steps = 0;
+  /// @brief Выделенные узлы.
+  size_type allocations = 0;
+  /// @brief Освобождённые узлы.
+  size_type deallocations = 0;
+  /// @brief Количество спусков от корня (поиск и вставка).
+  size_type descents = 0;
+  /// @brief Гистограмма глубины спуска: depth[d] - число спусков, прошедших
+  /// d узлов. Последний элемент учитывает все спуски глубже kMaxDepth.
+  std::array<size_type, kMaxDepth + 1> depth{};
+  /// @brief Узлы в дереве вместе с лениво удалёнными (заполняется всегда).
+  size_type nodes = 0;
+  /// @brief Лениво удалённые узлы (заполняется всегда).
+  size_type dead = 0;
+  /// @brief Поиски, отсечённые фильтром (TreeOptions::filter_policy). Как и
+  /// остальные счётчики, заполняется только политикой TreeStats.
+  size_type filter_negatives = 0;
+  /// @brief Поиски отсутствующих ключей, пропущенные фильтром.
+  size_type filter_false_positives = 0;
+
+  /// @brief Доля лениво удалённых узлов.
+  double DeadFraction() const noexcept {
+    return nodes == 0 ? 0 : static_cast<double>(dead) / nodes;
+  }
+
+  /// @brief Доля ложных срабатываний фильтра среди поисков отсутствующих
+  /// ключей.
+  double FilterFalsePositiveRate() const noexcept {
+    size_type misses = filter_negatives + filter_false_positives;
+    return misses == 0 ? 0 : static_cast<double>(filter_false_positives) /
+                                 misses;
+  }
+
+  /// @brief Средняя глубина спуска.
+  double AverageDepth() const noexcept {
+    if (descents == 0) {
+      return 0;
+    }
+    double sum = 0;
+    for (int d = 0; d <= kMaxDepth; ++d) {
+      sum += static_cast<double>(depth[d]) * d;
+    }
+    return sum / descents;
+  }
+};
+
+/// @brief Политика без сбора статистики: все счётчики - пустые функции.
+struct NoStats {
+  static constexpr bool enabled = false;
+
+  void Comparison() noexcept {}
+  void Rotation() noexcept {}
+  void InsertFixupStep() noexcept {}
+  void ExtractFixupStep() noexcept {}
+  void Allocation() noexcept {}
+  void Deallocation() noexcept {}
+  void Descent(int) noexcept {}
+  void FilterNegative() noexcept {}
+  void FilterFalsePositive() noexcept {}
+  void Reset() noexcept {}
+  TreeStatsSnapshot Snapshot() const noexcept { return {}; }
+};
+
+/// @brief Политика, считающая операции горячего пути дерева. Счётчики
+/// меняются и в константных поисках, поэтому одновременно читать такое
+/// дерево из нескольких потоков нельзя.
+struct TreeStats {
+  static constexpr bool enabled = true;
+
+  void Comparison() noexcept { ++data_.comparisons; }
+  void Rotation() noexcept { ++data_.rotations; }
+  void InsertFixupStep() noexcept { ++data_.insert_fixup_steps; }
+  void ExtractFixupStep() noexcept { ++data_.extract_fixup_steps; }
+  void Allocation() noexcept { ++data_.allocations; }
+  void Deallocation() noexcept { ++data_.deallocations; }
+  void Descent(int depth) noexcept {
+    ++data_.descents;
+    ++data_.depth[depth < TreeStatsSnapshot::kMaxDepth
+                      ? depth
+                      : TreeStatsSnapshot::kMaxDepth];
+  }
+  void FilterNegative() noexcept { ++data_.filter_negatives; }
+  void FilterFalsePositive() noexcept { ++data_.filter_false_positives; }
+  void Reset() noexcept { data_ = TreeStatsSnapshot(); }
+  TreeStatsSnapshot Snapshot() const noexcept { return data_; }
+
+ private:
+  TreeStatsSnapshot data_;
+};
+
+}  // namespace s21
+
+#endif  // S21_TREE_STATS_H_
@@ -0,0 +1,227 @@
+#ifndef S21_WINDOW_QUANTILES_H_
+#define S21_WINDOW_QUANTILES_H_
+
+#include <cmath>
+#include <deque>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_rbtree.h"
+
+namespace s21 {
+
+/// @brief Квантили скользящего окна (медиана, p99 и т.п.) за O(log n) на
+/// запрос. Значения хранятся в дереве с порядковой статистикой
+/// (TreeOptions::rank_policy = SubtreeRank), поэтому k-е значение
+/// находится спуском по размерам поддеревьев, а не обходом итератором.
+///
+/// Два режима устаревания:
+/// - окно из window последних значений (window > 0): push вытесняет самое
+///   старое значение, его узел переиспользуется для нового (см.
+///   RBTree::RecycleNode), pop убирает самое старое явно;
+/// - окно, которым управляет вызывающий (window == 0): значения убираются
+///   по значению через erase.
+/// @tparam Options Параметры дерева, rank_policy заменяется на SubtreeRank.
+template <typename T, typename Compare = std::less<T>,
+          typename Options = TreeOptions>
+class window_quantiles {
+ public:
+  struct RankedOptions : Options {
+    using rank_policy = SubtreeRank;
+  };
+
+  using value_type = T;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using tree_type = RBTree<value_type, Compare, RankedOptions>;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  /// @brief Конструктор.
+  /// @param window Размер окна, 0 - значения убирает вызывающий.
+  explicit window_quantiles(size_type window = 0)
+      : tree_(new tree_type()), window_(window) {}
+
+  window_quantiles(const window_quantiles &) = delete;
+  window_quantiles &operator=(const window_quantiles &) = delete;
+
+  /// @brief Конструктор перемещения.
+  window_quantiles(window_quantiles &&other) noexcept
+      : tree_(new tree_type()), window_(other.window_) {
+    swap(other);
+  }
+
+  /// @brief Оператор присваивания перемещением.
+  window_quantiles &operator=(window_quantiles &&other) noexcept {
+    if (this != &other) {
+      swap(other);
+      other.clear();
+    }
+    return *this;
+  }
+
+  /// @brief Деструктор.
+  ~window_quantiles() { delete tree_; }
+
+  /// @brief Итератор на наименьшее значение окна.
+  const_iterator begin() const { return tree_->Begin(); }
+
+  /// @brief Итератор за наибольшим значением окна.
+  const_iterator end() const { return tree_->End(); }
+
+  /// @brief Проверяет, пустое ли окно.
+  bool empty() const { return tree_->Size() == 0; }
+
+  /// @brief Количество значений в окне.
+  size_type size() const { return tree_->Size(); }
+
+  /// @brief Размер окна (0 - окном управляет вызывающий).
+  size_type window() const { return window_; }
+
+  /// @brief Очищает окно.
+  void clear() {
+    tree_->Clear();
+    fifo_.clear();
+  }
+
+  /// @brief Добавляет значение. В заполненном окне самое старое значение
+  /// вытесняется.
+  void push(const value_type &value) { Push(value); }
+
+  /// @brief Добавляет значение с перемещением (см. push).
+  void push(value_type &&value) { Push(std::move(value)); }
+
+  /// @brief Сдвиг окна на пакет значений. Если пакет не короче окна, окно
+  /// собирается заново из последних window значений пакета за
+  /// O(window log window) без поэлементных вставок и удалений.
+  template <typename ForwardIt>
+  void advance(ForwardIt first, ForwardIt last) {
+    size_type count = std::distance(first, last);
+    if (window_ == 0 || count < window_) {
+      for (; first != last; ++first) Push(*first);
+      return;
+    }
+    std::advance(first, count - window_);
+    std::vector<value_type> values(first, last);
+    // порядок значений по возрастанию, равные - в порядке поступления,
+    // как при вставке по одному
+    std::vector<size_type> order(window_);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&values](size_type a, size_type b) {
+                       return Compare()(values[a], values[b]);
+                     });
+    std::vector<value_type> sorted;
+    sorted.reserve(window_);
+    for (size_type index : order) sorted.push_back(std::move(values[index]));
+    std::deque<iterator> fifo(window_, tree_->End());
+    tree_->AssignSorted(std::make_move_iterator(sorted.begin()),
+                        std::make_move_iterator(sorted.end()), false);
+    iterator it = tree_->Begin();
+    for (size_type index : order) fifo[index] = it++;
+    fifo_.swap(fifo);
+  }
+
+  /// @brief Убирает самое старое значение окна (только при window > 0).
+  void pop() {
+    if (!fifo_.empty()) {
+      tree_->Erase(fifo_.front());
+      fifo_.pop_front();
+    }
+  }
+
+  /// @brief Убирает одно вхождение значения (только при window == 0).
+  /// @return true, если значение было в окне.
+  /// @throw std::logic_error, если окно задано размером.
+  bool erase(const value_type &value) {
+    if (window_ != 0) {
+      throw std::logic_error("s21::window_quantiles::erase: fixed window");
+    }
+    iterator it = tree_->Lower_Bound(value);
+    if (it == tree_->End() || Compare()(value, *it)) {
+      return false;
+    }
+    tree_->Erase(it);
+    return true;
+  }
+
+  /// @brief k-е по возрастанию значение окна (с нуля) за O(log n).
+  /// @throw std::out_of_range, если k >= size().
+  const_reference nth(size_type k) const {
+    if (k >= tree_->Size()) {
+      throw std::out_of_range("s21::window_quantiles::nth: out of range");
+    }
+    return *tree_->Select(k);
+  }
+
+  /// @brief Квантиль q из [0, 1] за O(log n): значение с номером
+  /// floor(q * (size() - 1)) по возрастанию, без интерполяции.
+  /// @throw std::out_of_range, если окно пустое, std::invalid_argument,
+  /// если q - NaN.
+  const_reference quantile(double q) const {
+    if (tree_->Size() == 0) {
+      throw std::out_of_range("s21::window_quantiles::quantile: empty");
+    }
+    if (std::isnan(q)) {
+      throw std::invalid_argument("s21::window_quantiles::quantile: NaN");
+    }
+    q = q < 0 ? 0 : q > 1 ? 1 : q;
+    return nth(static_cast<size_type>(q * (tree_->Size() - 1)));
+  }
+
+  /// @brief Медиана (нижняя при чётном размере).
+  const_reference median() const { return quantile(0.5); }
+
+  /// @brief Количество значений окна меньше value за O(log n).
+  size_type rank(const value_type &value) const { return tree_->Rank(value); }
+
+  /// @brief Обменивает содержимое с другим окном.
+  void swap(window_quantiles &other) noexcept {
+    std::swap(tree_, other.tree_);
+    std::swap(window_, other.window_);
+    fifo_.swap(other.fifo_);
+  }
+
+  /// @brief Снимок статистики горячего пути (см. TreeOptions::stats_policy).
+  TreeStatsSnapshot stats() const noexcept { return tree_->Stats(); }
+
+ private:
+  using iterator = typename tree_type::iterator;
+
+  template <typename V>
+  void Push(V &&value) {
+    if (window_ == 0) {
+      tree_->InsertKey(std::forward<V>(value), false);
+      return;
+    }
+    if (fifo_.size() < window_) {
+      iterator it = tree_->InsertKey(std::forward<V>(value), false).first;
+      try {
+        fifo_.push_back(it);
+      } catch (...) {
+        tree_->Erase(it);
+        throw;
+      }
+      return;
+    }
+    iterator it = tree_->End();
+    try {
+      it = tree_->RecycleNode(fifo_.front(), std::forward<V>(value));
+    } catch (...) {
+      fifo_.pop_front();  // узел старого значения уже удалён
+      throw;
+    }
+    fifo_.pop_front();
+    fifo_.push_back(it);
+  }
+
+  tree_type *tree_;
+  size_type window_;
+  /// @brief Значения окна в порядке поступления (при window > 0).
+  std::deque<iterator> fifo_;
+};
+
+}  // namespace s21
+
+#endif  // S21_WINDOW_QUANTILES_H_
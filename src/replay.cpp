@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "s21_containers.h"
+
+// Воспроизведение трасс операций над множествами.
+//
+// Формат трассы: по одной операции в строке, '#' - комментарий.
+//   insert <key>
+//   erase <key>              удаляет одно вхождение
+//   find <key>
+//   lower_bound <key>
+//   iterate <key> <n>        n элементов, начиная с lower_bound(key)
+//   merge <n> <key>...       слияние с множеством из n ключей
+//
+// Запуск:
+//   ./replay                 синтетическая трасса по test.txt
+//   ./replay <trace>         записанная трасса
+//   ./replay gen <ops>       вывод синтетической трассы по test.txt
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum OpType { kInsert, kErase, kFind, kLowerBound, kIterate, kMerge, kOpTypes };
+
+const char *const kOpNames[kOpTypes] = {"insert",  "erase",   "find",
+                                        "lower_bound", "iterate", "merge"};
+
+/// @brief Операция трассы.
+struct Op {
+  OpType type;
+  std::string key;
+  std::size_t count = 0;
+  std::vector<std::string> keys;
+};
+
+/// @brief Разбор трассы. Неизвестная операция - ошибка с номером строки.
+std::vector<Op> ParseTrace(std::istream &in) {
+  std::vector<Op> trace;
+  std::string line;
+  for (std::size_t number = 1; getline(in, line); ++number) {
+    std::istringstream fields(line);
+    std::string name;
+    if (!(fields >> name) || name[0] == '#') continue;
+    Op op;
+    auto type = std::find(std::begin(kOpNames), std::end(kOpNames), name);
+    if (type == std::end(kOpNames)) {
+      throw std::runtime_error("replay: unknown operation '" + name +
+                               "' at line " + std::to_string(number));
+    }
+    op.type = static_cast<OpType>(type - std::begin(kOpNames));
+    if (op.type == kMerge) {
+      fields >> op.count;
+      op.keys.resize(op.count);
+      for (auto &key : op.keys) fields >> key;
+    } else {
+      fields >> op.key;
+      if (op.type == kIterate) fields >> op.count;
+    }
+    if (!fields) {
+      throw std::runtime_error("replay: malformed line " +
+                               std::to_string(number));
+    }
+    trace.push_back(std::move(op));
+  }
+  return trace;
+}
+
+/// @brief Вывод трассы в формате ParseTrace.
+void WriteTrace(std::ostream &out, const std::vector<Op> &trace) {
+  for (const auto &op : trace) {
+    out << kOpNames[op.type];
+    if (op.type == kMerge) {
+      out << ' ' << op.count;
+      for (const auto &key : op.keys) out << ' ' << key;
+    } else {
+      out << ' ' << op.key;
+      if (op.type == kIterate) out << ' ' << op.count;
+    }
+    out << '\n';
+  }
+}
+
+/// @brief Синтетическая трасса: ключи - слова test.txt в порядке следования
+/// с номером копии файла, поэтому частоты ключей повторяют частоты слов, а
+/// множество растёт. Доли операций: 40% insert, 15% erase, 30% find,
+/// 8% lower_bound, 5% iterate, 2% merge.
+std::vector<Op> GenerateTrace(const std::string &path, std::size_t ops,
+                              unsigned seed = 39) {
+  std::vector<std::string> words;
+  for (const auto &word : s21::load_word_counts(path)) {
+    words.insert(words.end(), word.second, word.first);
+  }
+  if (words.empty()) throw std::runtime_error("replay: no words in " + path);
+  std::mt19937 gen(seed);
+  std::shuffle(words.begin(), words.end(), gen);
+  std::size_t next = 0, copy = 0;
+  auto key = [&] {
+    if (next == words.size()) {
+      next = 0;
+      ++copy;
+    }
+    return words[next++] + "." + std::to_string(gen() % (copy + 1));
+  };
+  std::discrete_distribution<int> mix({40, 15, 30, 8, 5, 2});
+  std::vector<Op> trace(ops);
+  for (auto &op : trace) {
+    op.type = static_cast<OpType>(mix(gen));
+    if (op.type == kMerge) {
+      op.count = 1 + gen() % 32;
+      op.keys.resize(op.count);
+      for (auto &k : op.keys) k = key();
+    } else {
+      op.key = key();
+      if (op.type == kIterate) op.count = 1 + gen() % 64;
+    }
+  }
+  return trace;
+}
+
+/// @brief Хэш результата операции, сравниваемый между реализациями.
+std::uint64_t Combine(std::uint64_t hash, std::uint64_t value) {
+  return (hash ^ value) * 0x100000001b3ull;
+}
+
+std::uint64_t Combine(std::uint64_t hash, const std::string &key) {
+  for (unsigned char c : key) hash = Combine(hash, c);
+  return Combine(hash, 0xff);
+}
+
+/// @brief Воспроизведение трассы на контейнере Set с замером каждой операции.
+template <typename Set, bool Multi>
+struct Replayer {
+  Set set;
+  std::vector<std::uint64_t> results;
+  std::array<std::vector<std::uint32_t>, kOpTypes> latency;
+  double seconds = 0;
+
+  void Run(const std::vector<Op> &trace) {
+    results.reserve(trace.size());
+    auto begin = Clock::now();
+    for (const auto &op : trace) {
+      auto start = Clock::now();
+      std::uint64_t result = Apply(op);
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - start);
+      latency[op.type].push_back(static_cast<std::uint32_t>(
+          std::min<std::int64_t>(ns.count(), UINT32_MAX)));
+      results.push_back(result);
+    }
+    seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+  }
+
+  std::uint64_t Apply(const Op &op) {
+    switch (op.type) {
+      case kInsert:
+        if constexpr (Multi) {
+          set.insert(op.key);
+          return 1;
+        } else {
+          return set.insert(op.key).second;
+        }
+      case kErase: {
+        auto it = set.find(op.key);
+        if (it == set.end()) return 0;
+        set.erase(it);
+        return 1;
+      }
+      case kFind:
+        return set.find(op.key) != set.end();
+      case kLowerBound: {
+        auto it = set.lower_bound(op.key);
+        return it == set.end() ? 0 : Combine(1, *it);
+      }
+      case kIterate: {
+        std::uint64_t hash = 1;
+        auto it = set.lower_bound(op.key);
+        for (std::size_t i = 0; i < op.count && it != set.end(); ++i, ++it) {
+          hash = Combine(hash, *it);
+        }
+        return hash;
+      }
+      case kMerge: {
+        Set other;
+        for (const auto &key : op.keys) other.insert(key);
+        set.merge(other);
+        return set.size() * 1000 + other.size();
+      }
+      default:
+        return 0;
+    }
+  }
+};
+
+/// @brief Вывод пропускной способности и перцентилей задержки по операциям.
+template <typename R>
+void Report(const char *name, R &replayer) {
+  printf("%s: %.2f ms, %.0f ops/s, final size %zu\n", name,
+         replayer.seconds * 1e3, replayer.results.size() / replayer.seconds,
+         replayer.set.size());
+  printf("  %-12s %9s %9s %9s %9s %9s\n", "op", "count", "p50 ns", "p99 ns",
+         "p999 ns", "max ns");
+  for (int type = 0; type < kOpTypes; ++type) {
+    auto &samples = replayer.latency[type];
+    if (samples.empty()) continue;
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+      return samples[std::min(samples.size() - 1,
+                              static_cast<std::size_t>(q * samples.size()))];
+    };
+    printf("  %-12s %9zu %9u %9u %9u %9u\n", kOpNames[type], samples.size(),
+           at(0.5), at(0.99), at(0.999), samples.back());
+  }
+}
+
+/// @brief Сравнение результатов двух реализаций.
+template <typename R1, typename R2>
+bool Check(const char *name, const R1 &a, const R2 &b,
+           const std::vector<Op> &trace) {
+  auto mismatch = std::mismatch(a.results.begin(), a.results.end(),
+                                b.results.begin(), b.results.end());
+  if (mismatch.first == a.results.end() && a.set.size() == b.set.size() &&
+      std::equal(a.set.begin(), a.set.end(), b.set.begin(), b.set.end())) {
+    printf("%s: results match\n", name);
+    return true;
+  }
+  std::size_t index = mismatch.first - a.results.begin();
+  printf("%s: MISMATCH at operation %zu", name, index);
+  if (index < trace.size()) {
+    printf(" (%s %s)", kOpNames[trace[index].type], trace[index].key.c_str());
+  }
+  printf("\n");
+  return false;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  try {
+    if (argc >= 2 && strcmp(argv[1], "gen") == 0) {
+      std::size_t ops = argc >= 3 ? std::stoul(argv[2]) : 200000;
+      WriteTrace(std::cout, GenerateTrace("test.txt", ops));
+      return 0;
+    }
+    std::vector<Op> trace;
+    if (argc >= 2) {
+      std::ifstream in(argv[1]);
+      if (!in) throw std::runtime_error("replay: cannot open " +
+                                        std::string(argv[1]));
+      trace = ParseTrace(in);
+    } else {
+      trace = GenerateTrace("test.txt", 200000);
+    }
+    printf("replay: %zu operations\n", trace.size());
+    Replayer<s21::set<std::string>, false> s21_set;
+    Replayer<std::set<std::string>, false> std_set;
+    Replayer<s21::multiset<std::string>, true> s21_multi;
+    Replayer<std::multiset<std::string>, true> std_multi;
+    s21_set.Run(trace);
+    std_set.Run(trace);
+    s21_multi.Run(trace);
+    std_multi.Run(trace);
+    Report("s21::set", s21_set);
+    Report("std::set", std_set);
+    Report("s21::multiset", s21_multi);
+    Report("std::multiset", std_multi);
+    bool ok = Check("set", s21_set, std_set, trace);
+    ok = Check("multiset", s21_multi, std_multi, trace) && ok;
+    return ok ? 0 : 1;
+  } catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return 2;
+  }
+}
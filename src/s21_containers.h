@@ -1,7 +1,21 @@
 #ifndef CONTAINERS_SRC_S21_CONTAINERS_H_
 #define CONTAINERS_SRC_S21_CONTAINERS_H_
 
+#include "headers/s21_bitmap_set.h"
+#include "headers/s21_bounded_multiset.h"
+#include "headers/s21_loader.h"
+#include "headers/s21_map.h"
+#include "headers/s21_mapped_set.h"
+#include "headers/s21_multimap.h"
 #include "headers/s21_multiset.h"
+#include "headers/s21_radix_multiset.h"
+#include "headers/s21_radix_set.h"
 #include "headers/s21_set.h"
+#include "headers/s21_set_views.h"
+#include "headers/s21_sharded_multiset.h"
+#include "headers/s21_static_set.h"
+#include "headers/s21_string_multiset.h"
+#include "headers/s21_string_set.h"
+#include "headers/s21_window_quantiles.h"
 
 #endif  // CONTAINERS_SRC_S21_CONTAINERS_H_
@@ -1,6 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string_view>
+#include <thread>
 
 #include "s21_containers.h"
 
@@ -391,6 +400,1647 @@ TEST(rbtree, operators) {
   EXPECT_EQ(rb2.Size(), 0);
 }
 
+TEST(rbtree, assign_sorted) {
+  for (int n = 0; n < 100; ++n) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; ++i) keys.push_back(i / 2);
+    s21::RBTree<int> rb1;
+    s21::RBTree<int> rb2;
+    rb1.AssignSorted(keys.begin(), keys.end(), false);
+    rb2.AssignSorted(keys.begin(), keys.end(), true);
+    EXPECT_EQ(rb1.Size(), keys.size());
+    EXPECT_EQ(rb2.Size(), static_cast<size_t>((n + 1) / 2));
+    EXPECT_NE(rb1.BlackHeight(), -1);
+    EXPECT_NE(rb2.BlackHeight(), -1);
+    EXPECT_TRUE(std::equal(keys.begin(), keys.end(), rb1.Begin()));
+    rb1.InsertKey(n, false);
+    rb1.Erase(rb1.Begin());
+    EXPECT_NE(rb1.BlackHeight(), -1);
+  }
+}
+
+TEST(loader, test_txt) {
+  std::ifstream file("test.txt");
+  std::string str;
+  std::multiset<std::string> std;
+  const char *delimiters = " \n\t,.:;!?-()[]{}'\"";
+  while (getline(file, str)) {
+    char *word = strtok((char *)str.data(), delimiters);
+    while (word != nullptr) {
+      std.insert(word);
+      word = strtok(nullptr, delimiters);
+    }
+  }
+  std::set<std::string> std_uniq(std.begin(), std.end());
+  for (unsigned threads : {0u, 1u, 3u, 8u}) {
+    s21::LoadOptions options;
+    options.threads = threads;
+    s21::set<std::string> s21 = s21::load_set("test.txt", options);
+    s21::multiset<std::string> s21_multi =
+        s21::load_multiset("test.txt", options);
+    EXPECT_EQ(s21.size(), std_uniq.size());
+    EXPECT_EQ(s21_multi.size(), std.size());
+    EXPECT_TRUE(std::equal(std_uniq.begin(), std_uniq.end(), s21.begin()));
+    EXPECT_TRUE(std::equal(std.begin(), std.end(), s21_multi.begin()));
+    EXPECT_EQ(s21_multi.count("the"), std.count("the"));
+
+    auto counts = s21::load_word_counts("test.txt", options);
+    EXPECT_EQ(counts.size(), std_uniq.size());
+    for (const auto &word : counts) {
+      EXPECT_EQ(word.second, std.count(word.first));
+    }
+  }
+  EXPECT_THROW(s21::load_set("no_such_file.txt"), std::runtime_error);
+}
+
+TEST(set, stats) {
+  struct Counted : s21::TreeOptions {
+    using stats_policy = s21::TreeStats;
+  };
+  s21::set<int, std::less<int>, Counted> s1;
+  for (int i = 0; i < 1000; ++i) s1.insert(i);
+  s1.insert(500);
+  auto stats = s1.stats();
+  EXPECT_EQ(stats.allocations, 1001u);
+  EXPECT_EQ(stats.deallocations, 1u);
+  EXPECT_GT(stats.rotations, 0u);
+  EXPECT_GT(stats.insert_fixup_steps, 0u);
+  EXPECT_EQ(stats.descents, 1001u);
+  EXPECT_GT(stats.comparisons, stats.descents);
+  EXPECT_GT(stats.AverageDepth(), 1.0);
+  EXPECT_LE(stats.AverageDepth(), 20.0);
+
+  s1.reset_stats();
+  EXPECT_TRUE(s1.contains(10));
+  EXPECT_EQ(s1.stats().descents, 1u);
+  for (int i = 0; i < 1000; i += 2) s1.erase(s1.find(i));
+  stats = s1.stats();
+  EXPECT_EQ(stats.deallocations, 500u);
+  EXPECT_GT(stats.extract_fixup_steps, 0u);
+
+  s21::set<int> s2{1, 2, 3};
+  EXPECT_EQ(s2.stats().comparisons, 0u);
+  EXPECT_EQ(s2.stats().descents, 0u);
+  EXPECT_TRUE(std::is_empty_v<s21::NoStats>);
+}
+
+TEST(string_set, test_txt) {
+  std::ifstream file("test.txt");
+  std::string str;
+  s21::string_set s21;
+  std::set<std::string> std;
+  const char *delimiters = " \n\t,.:;!?-()[]{}'\"";
+  while (getline(file, str)) {
+    char *word = strtok((char *)str.data(), delimiters);
+    while (word != nullptr) {
+      EXPECT_EQ(s21.insert(word).second, std.insert(word).second);
+      word = strtok(nullptr, delimiters);
+    }
+  }
+  std::string long1 = "a-very-long-word-that-does-not-fit-inline";
+  std::string long2 = "a-very-long-word-that-does-not-fit-inline-either";
+  for (const auto &word : {long1, long2, std::string("a-very-long-word-t"),
+                           std::string("a-very-long-word"),
+                           std::string("a\0b", 3), std::string("a")}) {
+    EXPECT_EQ(s21.insert(word).second, std.insert(word).second);
+  }
+  EXPECT_FALSE(s21.insert(long1).second);
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+
+  EXPECT_TRUE(s21.contains(long2));
+  EXPECT_FALSE(s21.contains("a-very-long-word-that-does-not-fit"));
+  EXPECT_EQ(*s21.lower_bound("up"), *std.lower_bound("up"));
+  EXPECT_EQ(*s21.upper_bound("down"), *std.upper_bound("down"));
+  EXPECT_TRUE(s21.find("bebra") == s21.end());
+
+  s21::string_set copy(s21);
+  s21.erase(s21.find(long1));
+  std.erase(long1);
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+  EXPECT_TRUE(copy.contains(long1));
+  s21.clear();
+  EXPECT_TRUE(s21.empty());
+  EXPECT_EQ(*copy.find(long2), long2);
+  EXPECT_GT(copy.arena_bytes(), 0u);
+
+  s21::string_set moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved.contains(long2));
+  s21 = moved;
+  EXPECT_TRUE(s21 == moved);
+}
+
+TEST(string_multiset, test_txt) {
+  std::ifstream file("test.txt");
+  std::string str;
+  s21::string_multiset s21;
+  std::multiset<std::string> std;
+  const char *delimiters = " \n\t,.:;!?-()[]{}'\"";
+  while (getline(file, str)) {
+    char *word = strtok((char *)str.data(), delimiters);
+    while (word != nullptr) {
+      s21.insert(word);
+      std.insert(word);
+      word = strtok(nullptr, delimiters);
+    }
+  }
+  std::string long_word = "a-very-long-word-that-does-not-fit-inline";
+  s21.insert(long_word, 3);
+  for (int i = 0; i < 3; ++i) std.insert(long_word);
+  EXPECT_EQ(s21.size(), std.size());
+  std::set<std::string> std_uniq(std.begin(), std.end());
+  EXPECT_EQ(s21.distinct(), std_uniq.size());
+  auto it = s21.begin();
+  for (const auto &word : std_uniq) {
+    EXPECT_EQ((*it).first, word);
+    EXPECT_EQ((*it).second, std.count(word));
+    ++it;
+  }
+  EXPECT_TRUE(it == s21.end());
+  EXPECT_EQ(s21.count("the"), std.count("the"));
+  EXPECT_EQ(s21.count(long_word), 3u);
+  EXPECT_EQ(s21.count("bebra"), 0u);
+  EXPECT_EQ((*s21.lower_bound("up")).first, *std.lower_bound("up"));
+  EXPECT_EQ((*s21.upper_bound("down")).first, *std.upper_bound("down"));
+
+  auto top = s21.top(5);
+  ASSERT_EQ(top.size(), 5u);
+  for (std::size_t i = 1; i < top.size(); ++i) {
+    EXPECT_GE(top[i - 1].second, top[i].second);
+  }
+  for (const auto &word : std_uniq) {
+    EXPECT_LE(std.count(word), top[0].second);
+  }
+  EXPECT_EQ(s21.by_frequency().size(), s21.distinct());
+
+  s21::string_multiset copy(s21);
+  s21.erase(s21.find("the"));
+  EXPECT_EQ(s21.count("the"), std.count("the") - 1);
+  EXPECT_TRUE(copy != s21);
+  s21.erase(s21.find(long_word));
+  s21.erase(s21.find(long_word));
+  s21.erase(s21.find(long_word));
+  EXPECT_FALSE(s21.contains(long_word));
+  EXPECT_EQ(copy.count(long_word), 3u);
+  EXPECT_EQ(s21.size(), std.size() - 4);
+  s21 = copy;
+  EXPECT_TRUE(s21 == copy);
+}
+
+TEST(set, three_way_compare) {
+  struct Counted : s21::TreeOptions {
+    using stats_policy = s21::TreeStats;
+  };
+  s21::set<int, std::less<int>, Counted> s1;
+  s21::multiset<std::string, std::less<std::string>, Counted> s2;
+  for (int i = 0; i < 1000; ++i) {
+    s1.insert(i * 7 % 1000);
+    s2.insert(std::to_string(i % 10));
+  }
+  s1.reset_stats();
+  for (int i = -10; i < 1010; ++i) {
+    EXPECT_EQ(s1.contains(i), i >= 0 && i < 1000);
+  }
+  auto stats = s1.stats();
+  double levels = stats.AverageDepth() * stats.descents;
+  EXPECT_EQ(static_cast<double>(stats.comparisons), levels);
+
+  s2.reset_stats();
+  s2.insert("5");
+  stats = s2.stats();
+  EXPECT_EQ(static_cast<double>(stats.comparisons),
+            stats.AverageDepth() * stats.descents);
+  EXPECT_EQ(s2.count("5"), 101u);
+  EXPECT_TRUE(std::is_sorted(s2.begin(), s2.end()));
+
+  struct Reverse {
+    bool operator()(int a, int b) const { return a > b; }
+    int compare(int a, int b) const { return (a < b) - (a > b); }
+  };
+  s21::set<int, Reverse> s3{1, 5, 3, 4, 2, 5};
+  std::set<int, std::greater<int>> std3{1, 5, 3, 4, 2, 5};
+  EXPECT_EQ(s3.size(), std3.size());
+  EXPECT_TRUE(std::equal(std3.begin(), std3.end(), s3.begin()));
+  EXPECT_TRUE(s3.contains(4));
+  EXPECT_FALSE(s3.contains(6));
+  EXPECT_TRUE((s21::HasThreeWayCompare<Reverse, int>::value));
+  EXPECT_TRUE(s21::HasKeyCompare<std::string>::value);
+  EXPECT_FALSE((s21::HasThreeWayCompare<std::less<int>, int>::value));
+}
+
+struct CopyCounter {
+  static int copies;
+  int value;
+  std::string payload;
+
+  CopyCounter(int v) : value(v), payload(64, 'x') {}
+  CopyCounter(int v, std::string p) : value(v), payload(std::move(p)) {}
+  CopyCounter(const CopyCounter &other)
+      : value(other.value), payload(other.payload) {
+    ++copies;
+  }
+  CopyCounter(CopyCounter &&) = default;
+  CopyCounter &operator=(const CopyCounter &) = default;
+  CopyCounter &operator=(CopyCounter &&) = default;
+  bool operator<(const CopyCounter &other) const { return value < other.value; }
+  bool operator!=(const CopyCounter &other) const {
+    return value != other.value;
+  }
+};
+
+int CopyCounter::copies = 0;
+
+TEST(set, move_only) {
+  s21::set<std::unique_ptr<int>> s1;
+  auto p = std::make_unique<int>(5);
+  int *raw = p.get();
+  EXPECT_TRUE(s1.insert(std::move(p)).second);
+  EXPECT_TRUE(s1.emplace(new int(7)).second);
+  s1.insert_many(std::make_unique<int>(1), std::make_unique<int>(2));
+  EXPECT_EQ(s1.size(), 4u);
+  EXPECT_TRUE(s1.contains(std::unique_ptr<int>()) == false);
+  EXPECT_EQ((*s1.find(*s1.begin())).get(), (*s1.begin()).get());
+  s21::set<std::unique_ptr<int>> s2(std::move(s1));
+  s1 = std::move(s2);
+  EXPECT_EQ(s1.size(), 4u);
+  bool found = false;
+  for (const auto &ptr : s1) found = found || ptr.get() == raw;
+  EXPECT_TRUE(found);
+
+  s21::multiset<std::unique_ptr<int>> m1;
+  m1.insert(std::make_unique<int>(1));
+  m1.emplace(new int(2));
+  m1.insert_many(std::make_unique<int>(3), std::unique_ptr<int>());
+  EXPECT_EQ(m1.size(), 4u);
+}
+
+TEST(set, no_copies) {
+  CopyCounter::copies = 0;
+  s21::set<CopyCounter> s1;
+  CopyCounter c(1);
+  s1.insert(std::move(c));
+  s1.emplace(2, std::string(100, 'y'));
+  s1.insert_many(CopyCounter(3), CopyCounter(4), 5);
+  s21::multiset<CopyCounter> m1;
+  m1.insert(CopyCounter(1));
+  m1.emplace(1);
+  m1.insert_many(CopyCounter(2), 3);
+  EXPECT_EQ(CopyCounter::copies, 0);
+  EXPECT_EQ(s1.size(), 5u);
+  EXPECT_EQ(m1.size(), 4u);
+  CopyCounter d(6);
+  s1.insert(d);
+  EXPECT_EQ(CopyCounter::copies, 1);
+}
+
+TEST(set, sorted_batch) {
+  std::mt19937 gen(21);
+  s21::set<int> s21;
+  std::set<int> std;
+  for (int i = 0; i < 2000; ++i) {
+    int key = static_cast<int>(gen() % 10000);
+    s21.insert(key);
+    std.insert(key);
+  }
+  std::vector<int> batch;
+  for (int i = 0; i < 700; ++i) batch.push_back(gen() % 10500 - 250);
+  std::sort(batch.begin(), batch.end());
+
+  auto found = s21.find_sorted_batch(batch.begin(), batch.end());
+  auto contains = s21.contains_sorted_batch(batch.begin(), batch.end());
+  ASSERT_EQ(found.size(), batch.size());
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    bool in_std = std.count(batch[i]) > 0;
+    EXPECT_EQ(contains[i], in_std);
+    EXPECT_EQ(found[i] != s21.end(), in_std);
+    if (in_std) {
+      EXPECT_EQ(*found[i], batch[i]);
+    }
+  }
+
+  auto inserted = s21.insert_sorted_batch(batch.begin(), batch.end());
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    EXPECT_EQ(inserted[i].second, std.insert(batch[i]).second);
+    EXPECT_EQ(*inserted[i].first, batch[i]);
+  }
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+
+  std::vector<int> unsorted{5, 3, 9000, 1, 1};
+  auto res = s21.find_sorted_batch(unsorted.begin(), unsorted.end());
+  for (std::size_t i = 0; i < unsorted.size(); ++i) {
+    EXPECT_EQ(res[i] != s21.end(), std.count(unsorted[i]) > 0);
+  }
+
+  s21::set<int> empty;
+  EXPECT_FALSE(empty.contains_sorted_batch(batch.begin(), batch.end())[0]);
+  empty.insert_sorted_batch(batch.begin(), batch.end());
+  std::set<int> std_batch(batch.begin(), batch.end());
+  EXPECT_TRUE(std::equal(std_batch.begin(), std_batch.end(), empty.begin()));
+}
+
+TEST(multiset, sorted_batch) {
+  std::mt19937 gen(42);
+  s21::multiset<int> s21;
+  std::multiset<int> std;
+  for (int round = 0; round < 3; ++round) {
+    std::vector<int> batch;
+    for (int i = 0; i < 500; ++i) batch.push_back(gen() % 300);
+    std::sort(batch.begin(), batch.end());
+    s21.insert_sorted_batch(batch.begin(), batch.end());
+    std.insert(batch.begin(), batch.end());
+    EXPECT_EQ(s21.size(), std.size());
+    EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+    auto contains = s21.contains_sorted_batch(batch.begin(), batch.end());
+    EXPECT_TRUE(std::all_of(contains.begin(), contains.end(),
+                            [](bool b) { return b; }));
+  }
+  EXPECT_EQ(s21.count(7), std.count(7));
+}
+
+TEST(set, avl_balance) {
+  struct AVL : s21::TreeOptions {
+    using balance_policy = s21::AVLBalance;
+  };
+  std::mt19937 gen(33);
+  s21::set<int, std::less<int>, AVL> s21;
+  s21::multiset<int, std::less<int>, AVL> s21_multi;
+  s21::RBTree<int> rb;
+  std::set<int> std;
+  std::multiset<int> std_multi;
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    EXPECT_EQ(s21.insert(key).second, std.insert(key).second);
+    s21_multi.insert(key);
+    std_multi.insert(key);
+    rb.InsertKey(key, true);
+    if (i % 3 == 0) {
+      int victim = static_cast<int>(gen() % 3000);
+      auto it = s21.find(victim);
+      if (it != s21.end()) s21.erase(it);
+      std.erase(victim);
+      auto mit = s21_multi.find(victim);
+      if (mit != s21_multi.end()) s21_multi.erase(mit);
+      auto sit = std_multi.find(victim);
+      if (sit != std_multi.end()) std_multi.erase(sit);
+    }
+  }
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_EQ(s21_multi.size(), std_multi.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+  EXPECT_TRUE(
+      std::equal(std_multi.begin(), std_multi.end(), s21_multi.begin()));
+  EXPECT_EQ(s21_multi.count(100), std_multi.count(100));
+  EXPECT_EQ(*s21_multi.lower_bound(1500), *std_multi.lower_bound(1500));
+
+  s21::RBTree<int, std::less<int>, AVL> avl;
+  for (int i = 0; i < 4096; ++i) avl.InsertKey(i, true);
+  EXPECT_TRUE(avl.IsBalanced());
+  EXPECT_TRUE(rb.IsBalanced());
+  for (int i = 0; i < 4096; i += 3) avl.Erase(avl.Find(i));
+  EXPECT_TRUE(avl.IsBalanced());
+  s21::RBTree<int, std::less<int>, AVL> copy(avl);
+  EXPECT_TRUE(copy.IsBalanced());
+  EXPECT_TRUE(copy == avl);
+  std::vector<int> sorted(1000);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  copy.AssignSorted(sorted.begin(), sorted.end(), true);
+  EXPECT_TRUE(copy.IsBalanced());
+  copy.MergeMulti(avl);
+  EXPECT_TRUE(copy.IsBalanced());
+  EXPECT_LE(copy.AverageDepth(), 12.0);
+}
+
+TEST(set, lazy_erase) {
+  std::mt19937 gen(34);
+  s21::set<int> s21;
+  s21::multiset<int> s21_multi;
+  std::set<int> std;
+  std::multiset<int> std_multi;
+  s21.set_lazy_erase(0.5);
+  s21_multi.set_lazy_erase(0.5);
+  for (int i = 0; i < 6000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    EXPECT_EQ(s21.insert(key).second, std.insert(key).second);
+    s21_multi.insert(key);
+    std_multi.insert(key);
+    if (i % 2 == 0) {
+      int victim = static_cast<int>(gen() % 2000);
+      auto it = s21.find(victim);
+      EXPECT_EQ(it != s21.end(), std.erase(victim) == 1);
+      if (it != s21.end()) s21.erase(it);
+      EXPECT_FALSE(s21.contains(victim));
+      auto mit = s21_multi.find(victim);
+      auto sit = std_multi.find(victim);
+      EXPECT_EQ(mit != s21_multi.end(), sit != std_multi.end());
+      if (mit != s21_multi.end()) s21_multi.erase(mit);
+      if (sit != std_multi.end()) std_multi.erase(sit);
+      EXPECT_EQ(s21_multi.contains(victim), std_multi.count(victim) > 0);
+    }
+  }
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_EQ(s21_multi.size(), std_multi.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+  EXPECT_TRUE(
+      std::equal(std_multi.begin(), std_multi.end(), s21_multi.begin()));
+  EXPECT_EQ(s21_multi.count(100), std_multi.count(100));
+  EXPECT_EQ(*s21_multi.lower_bound(1000), *std_multi.lower_bound(1000));
+  EXPECT_EQ(*s21_multi.upper_bound(1000), *std_multi.upper_bound(1000));
+
+  s21::set<int> copy(s21);
+  EXPECT_TRUE(copy == s21);
+  EXPECT_EQ(copy.stats().dead, 0u);
+  EXPECT_LE(s21.stats().DeadFraction(), 0.5);
+  s21.compact();
+  EXPECT_EQ(s21.stats().dead, 0u);
+  EXPECT_EQ(s21.stats().nodes, std.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+
+  s21::RBTree<int> tree;
+  tree.SetLazyErase(1.0);
+  for (int i = 0; i < 100; ++i) tree.InsertKey(i, true);
+  for (int i = 0; i < 100; i += 2) tree.Erase(tree.Find(i));
+  EXPECT_EQ(tree.Size(), 50u);
+  EXPECT_EQ(tree.Stats().dead, 50u);
+  EXPECT_TRUE(tree.InsertKey(10, true).second);
+  EXPECT_FALSE(tree.InsertKey(11, true).second);
+  EXPECT_EQ(tree.Stats().dead, 49u);
+  EXPECT_TRUE(tree.IsBalanced());
+  std::vector<int> batch = {0, 1, 2, 3};
+  auto found = tree.ContainsSortedBatch(batch.begin(), batch.end());
+  EXPECT_EQ(found, std::vector<bool>({false, true, false, true}));
+  for (int i = 1; i < 100; i += 2) tree.Erase(tree.Find(i));
+  tree.Erase(tree.Find(10));
+  EXPECT_EQ(tree.Size(), 0u);
+  EXPECT_EQ(tree.Stats().nodes, 0u);
+  EXPECT_TRUE(tree.Begin() == tree.End());
+}
+
+TEST(map, basic) {
+  struct Counted : s21::TreeOptions {
+    using stats_policy = s21::TreeStats;
+  };
+  s21::map<std::string, int, std::less<std::string>, Counted> s21 = {
+      {"one", 1}, {"two", 2}};
+  std::map<std::string, int> std = {{"one", 1}, {"two", 2}};
+  s21["three"] = 3;
+  std["three"] = 3;
+  ++s21["one"];
+  ++std["one"];
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+  EXPECT_EQ(s21.at("two"), 2);
+  EXPECT_THROW(s21.at("four"), std::out_of_range);
+  EXPECT_FALSE(s21.insert({"two", 22}).second);
+  EXPECT_EQ(s21.at("two"), 2);
+  EXPECT_FALSE(s21.insert_or_assign("two", 22).second);
+  EXPECT_EQ(s21.at("two"), 22);
+  EXPECT_TRUE(s21.insert_or_assign("four", 4).second);
+
+  std::string value = "moved";
+  s21::map<int, std::string, std::less<int>, Counted> names;
+  EXPECT_TRUE(names.try_emplace(1, std::move(value)).second);
+  value = "kept";
+  names.reset_stats();
+  EXPECT_FALSE(names.try_emplace(1, std::move(value)).second);
+  EXPECT_EQ(value, "kept");
+  EXPECT_EQ(names[1], "moved");
+  EXPECT_EQ(names.stats().allocations, 0u);
+  EXPECT_EQ(names.stats().descents, 2u);
+
+  EXPECT_EQ(s21.erase("one"), 1u);
+  EXPECT_EQ(s21.erase("one"), 0u);
+  EXPECT_FALSE(s21.contains("one"));
+  EXPECT_EQ(s21.lower_bound("p")->first, "three");
+  s21::map<std::string, int, std::less<std::string>, Counted> copy(s21);
+  EXPECT_TRUE(copy == s21);
+  copy["five"] = 5;
+  s21.merge(copy);
+  EXPECT_EQ(s21.size(), 4u);
+  EXPECT_EQ(copy.size(), 3u);
+}
+
+TEST(map, multimap) {
+  s21::multimap<int, char> s21;
+  std::multimap<int, char> std;
+  std::mt19937 gen(35);
+  for (int i = 0; i < 2000; ++i) {
+    int key = static_cast<int>(gen() % 300);
+    char value = static_cast<char>('a' + i % 26);
+    s21.insert({key, value});
+    std.insert({key, value});
+  }
+  EXPECT_EQ(s21.size(), std.size());
+  EXPECT_TRUE(std::equal(std.begin(), std.end(), s21.begin()));
+  for (int key = 0; key < 300; key += 7) {
+    EXPECT_EQ(s21.count(key), std.count(key));
+    EXPECT_EQ(s21.contains(key), std.count(key) > 0);
+  }
+  auto range = s21.equal_range(42);
+  auto std_range = std.equal_range(42);
+  EXPECT_TRUE(std::equal(std_range.first, std_range.second, range.first));
+  s21.erase(s21.find(42));
+  std.erase(std.find(42));
+  EXPECT_EQ(s21.count(42), std.count(42));
+  EXPECT_EQ(s21.find(1000), s21.end());
+  EXPECT_EQ(s21.emplace(7, 'z')->second, 'z');
+}
+
+TEST(set, fingerprint) {
+  struct Fingerprinted : s21::TreeOptions {
+    using fingerprint_policy = s21::HashFingerprint;
+  };
+  using set = s21::set<int, std::less<int>, Fingerprinted>;
+  using multiset = s21::multiset<int, std::less<int>, Fingerprinted>;
+  set a, b;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(i);
+    b.insert(999 - i);
+  }
+  EXPECT_NE(a.fingerprint(), 0u);
+  EXPECT_EQ(a.fingerprint(), b.fingerprint());
+  EXPECT_TRUE(a == b);
+  b.erase(b.find(500));
+  b.insert(1000);
+  EXPECT_NE(a.fingerprint(), b.fingerprint());
+  EXPECT_TRUE(a != b);
+  b.erase(b.find(1000));
+  b.set_lazy_erase(0.5);
+  b.insert(500);
+  EXPECT_EQ(a.fingerprint(), b.fingerprint());
+  b.erase(b.find(7));
+  EXPECT_NE(a.fingerprint(), b.fingerprint());
+  b.insert(7);
+  EXPECT_EQ(a.fingerprint(), b.fingerprint());
+
+  set copy(a);
+  EXPECT_EQ(copy.fingerprint(), a.fingerprint());
+  set other = {2000, 2001};
+  std::uint64_t before = other.fingerprint();
+  copy.merge(other);
+  EXPECT_EQ(other.fingerprint(), 0u);
+  copy.swap(other);
+  EXPECT_EQ(copy.fingerprint(), 0u);
+  other.clear();
+  EXPECT_EQ(other.fingerprint(), 0u);
+  std::vector<int> sorted = {2000, 2001};
+  other.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(other.fingerprint(), before);
+
+  multiset m1 = {1, 1, 2}, m2 = {1, 2, 2}, m3 = {2, 1, 1};
+  EXPECT_NE(m1.fingerprint(), m2.fingerprint());
+  EXPECT_EQ(m1.fingerprint(), m3.fingerprint());
+  m2.merge(m3);
+  EXPECT_EQ(m3.fingerprint(), 0u);
+  EXPECT_EQ(s21::set<int>({1, 2}).fingerprint(), 0u);
+}
+
+TEST(set, split_ranges) {
+  s21::set<int> s21;
+  std::vector<int> keys(100000);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(37));
+  for (int k : keys) s21.insert(k);
+  for (std::size_t k = 1; k <= 16; ++k) {
+    auto ranges = s21.split_ranges(k);
+    EXPECT_EQ(ranges.size(), k);
+    EXPECT_TRUE(ranges.front().first == s21.begin());
+    EXPECT_TRUE(ranges.back().second == s21.end());
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+      if (i > 0) {
+        EXPECT_TRUE(ranges[i].first == ranges[i - 1].second);
+      }
+      std::size_t size = 0;
+      for (auto it = ranges[i].first; it != ranges[i].second; ++it) ++size;
+      EXPECT_GE(size, keys.size() / k / 3);
+      EXPECT_LE(size, keys.size() / k * 3);
+      total += size;
+    }
+    EXPECT_EQ(total, keys.size());
+  }
+  EXPECT_TRUE(s21::set<int>().split_ranges(4).empty());
+  EXPECT_EQ(s21::set<int>({1, 2}).split_ranges(8).size(), 2u);
+
+  s21::multiset<int> multi;
+  for (int i = 0; i < 5000; ++i) multi.insert(i % 100);
+  multi.set_lazy_erase(0.9);
+  for (int i = 0; i < 2000; ++i) multi.erase(multi.find(i % 50));
+  std::atomic<long> sum = 0;
+  std::atomic<int> count = 0;
+  multi.parallel_for_each(
+      [&](int key) {
+        sum += key;
+        ++count;
+      },
+      4);
+  long expected = std::accumulate(multi.begin(), multi.end(), 0L);
+  EXPECT_EQ(count, 3000);
+  EXPECT_EQ(sum, expected);
+  EXPECT_THROW(multi.parallel_for_each(
+                   [](int key) {
+                     if (key == 77) throw std::runtime_error("bad key");
+                   },
+                   3),
+               std::runtime_error);
+}
+
+TEST(set, views) {
+  std::mt19937 gen(38);
+  s21::set<int> a, b, c;
+  std::set<int> std_a, std_b, std_c;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+    a.insert(key);
+    std_a.insert(key);
+    if (i % 30 == 0) {
+      b.insert(key + 1);
+      std_b.insert(key + 1);
+    }
+    c.insert(key / 2);
+    std_c.insert(key / 2);
+  }
+  auto check = [](const auto &view, const std::vector<int> &expected) {
+    std::vector<int> got;
+    for (int key : view) got.push_back(key);
+    EXPECT_EQ(got, expected);
+  };
+  std::vector<int> expected;
+  std::set_union(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                 std::back_inserter(expected));
+  check(s21::union_view(a, b), expected);
+  expected.clear();
+  std::set_intersection(std_a.begin(), std_a.end(), std_b.begin(),
+                        std_b.end(), std::back_inserter(expected));
+  check(s21::intersection_view(a, b), expected);
+  check(s21::intersection_view(b, a), expected);
+  expected.clear();
+  std::set_difference(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                      std::back_inserter(expected));
+  check(s21::difference_view(a, b), expected);
+  expected.clear();
+  std::set_difference(std_b.begin(), std_b.end(), std_a.begin(), std_a.end(),
+                      std::back_inserter(expected));
+  check(s21::difference_view(b, a), expected);
+
+  std::vector<int> inner, outer;
+  std::set_intersection(std_a.begin(), std_a.end(), std_c.begin(),
+                        std_c.end(), std::back_inserter(inner));
+  std::set_union(inner.begin(), inner.end(), std_b.begin(), std_b.end(),
+                 std::back_inserter(outer));
+  auto nested = s21::union_view(s21::intersection_view(a, c), b);
+  check(nested, outer);
+  auto it = nested.lower_bound(2500);
+  EXPECT_EQ(*it, *std::lower_bound(outer.begin(), outer.end(), 2500));
+
+  std::size_t taken = 0;
+  for (int key : s21::difference_view(a, b)) {
+    EXPECT_EQ(key, *std::next(std_a.begin(), taken));
+    if (++taken == 5) break;
+  }
+  EXPECT_EQ(taken, 5u);
+  s21::set<int> empty;
+  EXPECT_TRUE(s21::intersection_view(a, empty).empty());
+  EXPECT_TRUE(std::equal(std_a.begin(), std_a.end(),
+                         s21::union_view(a, empty).begin()));
+
+  s21::multiset<int> m1 = {1, 1, 2, 3, 3, 3}, m2 = {1, 3, 3, 4};
+  std::multiset<int> s1 = {1, 1, 2, 3, 3, 3}, s2 = {1, 3, 3, 4};
+  expected.clear();
+  std::merge(s1.begin(), s1.end(), s2.begin(), s2.end(),
+             std::back_inserter(expected));
+  check(s21::merge_view(m1, m2), expected);
+  expected.clear();
+  std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                 std::back_inserter(expected));
+  check(s21::union_view(m1, m2), expected);
+  expected.clear();
+  std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                        std::back_inserter(expected));
+  check(s21::intersection_view(m1, m2), expected);
+  expected.clear();
+  std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                      std::back_inserter(expected));
+  check(s21::difference_view(m1, m2), expected);
+}
+
+TEST(set, huge_page_arena) {
+  struct Arena : s21::TreeOptions {
+    using allocation_policy = s21::HugePageArena;
+  };
+  using set = s21::set<int, std::less<int>, Arena>;
+  std::mt19937 gen(40);
+  set a, b;
+  std::set<int> std_a, std_b;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 30000);
+    EXPECT_EQ(a.insert(key).second, std_a.insert(key).second);
+    b.insert(key / 2);
+    std_b.insert(key / 2);
+    if (i % 4 == 0) {
+      int victim = static_cast<int>(gen() % 30000);
+      auto it = a.find(victim);
+      if (it != a.end()) a.erase(it);
+      std_a.erase(victim);
+    }
+  }
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), std_a.begin(), std_a.end()));
+
+  set copy = a;
+  a.merge(b);
+  std::set<int> left;
+  for (int key : std_b) {
+    if (!std_a.insert(key).second) left.insert(key);
+  }
+  std_b = left;
+  EXPECT_EQ(a.size(), std_a.size());
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), std_a.begin(), std_a.end()));
+  EXPECT_TRUE(std::equal(b.begin(), b.end(), std_b.begin(), std_b.end()));
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  a = copy;
+  EXPECT_TRUE(a == copy);
+
+  s21::multiset<std::string, std::less<std::string>, Arena> words, more;
+  for (int i = 0; i < 3000; ++i) {
+    words.insert(std::to_string(i % 700) + "-long-enough-to-allocate");
+    more.insert(std::to_string(i % 300));
+  }
+  std::vector<std::string> sorted(words.begin(), words.end());
+  words.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_TRUE(std::equal(words.begin(), words.end(), sorted.begin(),
+                         sorted.end()));
+  words.merge(more);
+  EXPECT_EQ(words.size(), 6000u);
+  EXPECT_TRUE(more.empty());
+  EXPECT_TRUE(std::is_sorted(words.begin(), words.end()));
+}
+
+template <typename Key>
+void CheckRadix(unsigned seed, std::uint64_t range) {
+  std::mt19937_64 gen(seed);
+  auto random_key = [&] {
+    return static_cast<Key>(gen() % range - (std::is_signed_v<Key> ? range / 2
+                                                                   : 0));
+  };
+  s21::radix_set<Key> s21;
+  s21::radix_multiset<Key> s21_multi;
+  std::set<Key> std;
+  std::multiset<Key> std_multi;
+  for (int i = 0; i < 20000; ++i) {
+    Key key = random_key();
+    EXPECT_EQ(s21.insert(key).second, std.insert(key).second);
+    EXPECT_EQ(*s21_multi.insert(key), key);
+    std_multi.insert(key);
+    if (i % 3 == 0) {
+      Key victim = random_key();
+      auto it = s21.find(victim);
+      if (it != s21.end()) s21.erase(it);
+      std.erase(victim);
+      auto mit = s21_multi.find(victim);
+      if (mit != s21_multi.end()) s21_multi.erase(mit);
+      auto smit = std_multi.find(victim);
+      if (smit != std_multi.end()) std_multi.erase(smit);
+    }
+  }
+  ASSERT_EQ(s21.size(), std.size());
+  ASSERT_EQ(s21_multi.size(), std_multi.size());
+  EXPECT_TRUE(std::equal(s21.begin(), s21.end(), std.begin(), std.end()));
+  EXPECT_TRUE(std::equal(s21_multi.begin(), s21_multi.end(),
+                         std_multi.begin(), std_multi.end()));
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(s21_multi.end()),
+                         std::make_reverse_iterator(s21_multi.begin()),
+                         std_multi.rbegin(), std_multi.rend()));
+  for (int i = 0; i < 2000; ++i) {
+    Key key = random_key();
+    auto lower = s21.lower_bound(key);
+    auto std_lower = std.lower_bound(key);
+    ASSERT_EQ(lower == s21.end(), std_lower == std.end());
+    if (lower != s21.end()) {
+      EXPECT_EQ(*lower, *std_lower);
+    }
+    auto upper = s21_multi.upper_bound(key);
+    auto std_upper = std_multi.upper_bound(key);
+    ASSERT_EQ(upper == s21_multi.end(), std_upper == std_multi.end());
+    if (upper != s21_multi.end()) {
+      EXPECT_EQ(*upper, *std_upper);
+    }
+    EXPECT_EQ(s21_multi.count(key), std_multi.count(key));
+    EXPECT_EQ(s21.contains(key), std.count(key) == 1);
+  }
+}
+
+TEST(radix_set, against_std) {
+  CheckRadix<std::uint32_t>(41, 5000);
+  CheckRadix<std::uint64_t>(42, ~std::uint64_t(0));
+  CheckRadix<int>(43, 6000);
+  CheckRadix<long long>(44, ~std::uint64_t(0));
+  CheckRadix<unsigned char>(45, 256);
+  CheckRadix<short>(46, 65536);
+}
+
+TEST(radix_set, operations) {
+  s21::radix_set<int> a = {5, -3, 1000000, 7, 5}, b = {7, 8, -3, 9};
+  EXPECT_EQ(a.size(), 4u);
+  auto kept = a.find(7);
+  a.merge(b);
+  EXPECT_EQ(a.size(), 6u);
+  EXPECT_EQ(b.size(), 2u);
+  EXPECT_EQ(*kept, 7);
+  EXPECT_EQ(*b.begin(), -3);
+  s21::radix_set<int> copy = a;
+  EXPECT_TRUE(copy == a);
+  copy.erase(copy.find(1000000));
+  EXPECT_TRUE(copy != a);
+  EXPECT_EQ(*std::prev(copy.end()), 9);
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(copy.begin(), copy.end());
+
+  s21::radix_multiset<std::uint64_t> m = {3, 1, 3, 3, 2}, n = {3, 4};
+  EXPECT_EQ(m.count(3), 3u);
+  auto range = m.equal_range(3);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+  m.merge(n);
+  EXPECT_TRUE(n.empty());
+  EXPECT_EQ(m.count(3), 4u);
+  EXPECT_EQ(m.size(), 7u);
+
+  s21::radix_set<std::uint16_t> dense;
+  std::vector<std::uint16_t> keys(4000);
+  std::iota(keys.begin(), keys.end(), 0);
+  for (auto key : keys) dense.insert(key);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(41));
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    dense.erase(dense.find(keys[i]));
+    if (i % 500 == 0) {
+      std::vector<std::uint16_t> rest(keys.begin() + i + 1, keys.end());
+      std::sort(rest.begin(), rest.end());
+      EXPECT_TRUE(std::equal(dense.begin(), dense.end(), rest.begin(),
+                             rest.end()));
+    }
+  }
+  EXPECT_TRUE(dense.empty());
+
+  static_assert(std::is_same_v<s21::ordered_set<std::uint32_t>,
+                               s21::radix_set<std::uint32_t>>);
+  static_assert(std::is_same_v<s21::ordered_set<std::string>,
+                               s21::set<std::string>>);
+  static_assert(std::is_same_v<s21::ordered_multiset<int, std::greater<int>>,
+                               s21::multiset<int, std::greater<int>>>);
+  s21::set<int> rb = {-3, 1, 7};
+  std::vector<int> both(s21::intersection_view(a, rb).begin(),
+                        s21::intersection_view(a, rb).end());
+  EXPECT_EQ(both, std::vector<int>({-3, 7}));
+}
+
+TEST(bitmap_set, against_std) {
+  std::mt19937 gen(42);
+  s21::bitmap_set<std::uint32_t> a, b;
+  std::set<std::uint32_t> std_a, std_b;
+  // плотный блок, разреженный блок и одиночные ключи далеко друг от друга
+  auto random_key = [&] {
+    switch (gen() % 3) {
+      case 0:
+        return static_cast<std::uint32_t>(gen() % 20000);
+      case 1:
+        return static_cast<std::uint32_t>(0x50000 + gen() % 65536);
+      default:
+        return static_cast<std::uint32_t>(gen());
+    }
+  };
+  for (int i = 0; i < 30000; ++i) {
+    std::uint32_t key = random_key();
+    EXPECT_EQ(a.insert(key).second, std_a.insert(key).second);
+    key = random_key();
+    b.insert(key);
+    std_b.insert(key);
+    if (i % 4 == 0) {
+      std::uint32_t victim = static_cast<std::uint32_t>(gen() % 20000);
+      auto it = a.find(victim);
+      if (it != a.end()) a.erase(it);
+      std_a.erase(victim);
+    }
+  }
+  ASSERT_EQ(a.size(), std_a.size());
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), std_a.begin(), std_a.end()));
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(a.end()),
+                         std::make_reverse_iterator(a.begin()),
+                         std_a.rbegin(), std_a.rend()));
+  for (int i = 0; i < 3000; ++i) {
+    std::uint32_t key = random_key();
+    EXPECT_EQ(a.contains(key), std_a.count(key) == 1);
+    auto lower = a.lower_bound(key);
+    auto std_lower = std_a.lower_bound(key);
+    ASSERT_EQ(lower == a.end(), std_lower == std_a.end());
+    if (lower != a.end()) {
+      EXPECT_EQ(*lower, *std_lower);
+    }
+    auto upper = a.upper_bound(key);
+    auto std_upper = std_a.upper_bound(key);
+    ASSERT_EQ(upper == a.end(), std_upper == std_a.end());
+    if (upper != a.end()) {
+      EXPECT_EQ(*upper, *std_upper);
+    }
+  }
+
+  std::vector<std::uint32_t> expected;
+  auto check = [&](auto op, auto std_op) {
+    auto res = a;
+    (res.*op)(b);
+    expected.clear();
+    std_op(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+           std::back_inserter(expected));
+    EXPECT_EQ(res.size(), expected.size());
+    EXPECT_TRUE(std::equal(res.begin(), res.end(), expected.begin(),
+                           expected.end()));
+  };
+  using bitmap = s21::bitmap_set<std::uint32_t>;
+  using It = std::set<std::uint32_t>::iterator;
+  using Out = std::back_insert_iterator<std::vector<std::uint32_t>>;
+  check(&bitmap::union_with, std::set_union<It, It, Out>);
+  check(&bitmap::intersect_with, std::set_intersection<It, It, Out>);
+  check(&bitmap::difference_with, std::set_difference<It, It, Out>);
+
+  auto merged = a, rest = b;
+  merged.merge(rest);
+  EXPECT_EQ(merged.size() + rest.size(), a.size() + b.size());
+  auto common = a;
+  common.intersect_with(b);
+  EXPECT_TRUE(rest == common);
+  auto all = a;
+  all.union_with(b);
+  EXPECT_TRUE(merged == all);
+  EXPECT_TRUE(merged != a);
+}
+
+TEST(bitmap_set, operations) {
+  s21::set<int> tree = {-70000, -5, 0, 3, 65536, 1 << 30};
+  s21::bitmap_set<int> ids(tree);
+  EXPECT_EQ(ids.size(), tree.size());
+  EXPECT_TRUE(std::equal(ids.begin(), ids.end(), tree.begin(), tree.end()));
+  EXPECT_EQ(*ids.lower_bound(-6), -5);
+  EXPECT_EQ(*ids.upper_bound(3), 65536);
+  EXPECT_EQ(*std::prev(ids.end()), 1 << 30);
+  auto res = ids.insert_many(4, 3, -70000, 7);
+  EXPECT_EQ(res.size(), 4u);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(*res[2].first, -70000);
+  EXPECT_EQ(*res[3].first, 7);
+  EXPECT_EQ(ids.size(), 8u);
+
+  s21::bitmap_set<std::uint16_t> dense;
+  for (unsigned i = 0; i < 60000; ++i) dense.insert(i);
+  EXPECT_EQ(dense.size(), 60000u);
+  EXPECT_EQ(*dense.lower_bound(12345), 12345);
+  for (unsigned i = 0; i < 59990; ++i) dense.erase(dense.find(i));
+  EXPECT_EQ(dense.size(), 10u);
+  EXPECT_EQ(*dense.begin(), 59990);
+  s21::set<std::uint16_t> small = {59991, 59999, 7};
+  std::vector<std::uint16_t> both(
+      s21::intersection_view(dense, small).begin(),
+      s21::intersection_view(dense, small).end());
+  EXPECT_EQ(both, std::vector<std::uint16_t>({59991, 59999}));
+  dense.clear();
+  EXPECT_TRUE(dense.empty());
+  EXPECT_EQ(dense.begin(), dense.end());
+}
+
+TEST(set, bloom_filter) {
+  struct Filtered : s21::TreeOptions {
+    using filter_policy = s21::BloomFilter;
+    using stats_policy = s21::TreeStats;
+  };
+  std::mt19937 gen(43);
+  s21::set<int, std::less<int>, Filtered> s21;
+  std::set<int> std;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 1000000);
+    EXPECT_EQ(s21.insert(key).second, std.insert(key).second);
+  }
+  for (int key : std) ASSERT_TRUE(s21.contains(key));
+  s21.reset_stats();
+  std::size_t absent = 0;
+  for (int i = 0; i < 20000; ++i) {
+    int key = 1000000 + static_cast<int>(gen() % 1000000);
+    EXPECT_FALSE(s21.contains(key));
+    EXPECT_TRUE(s21.find(key) == s21.end());
+    absent += 2;
+  }
+  auto stats = s21.stats();
+  EXPECT_EQ(stats.filter_negatives + stats.filter_false_positives, absent);
+  EXPECT_LT(stats.FilterFalsePositiveRate(), 0.03);
+
+  // удаления: фильтр перестраивается, удалённые ключи не находятся
+  std::vector<int> keys(std.begin(), std.end());
+  std::shuffle(keys.begin(), keys.end(), gen);
+  for (std::size_t i = 0; i < keys.size() * 3 / 4; ++i) {
+    s21.erase(s21.find(keys[i]));
+    std.erase(keys[i]);
+  }
+  s21.set_lazy_erase(0.3);
+  for (std::size_t i = keys.size() * 3 / 4; i < keys.size() * 7 / 8; ++i) {
+    s21.erase(s21.find(keys[i]));
+    std.erase(keys[i]);
+  }
+  for (int key : keys) EXPECT_EQ(s21.contains(key), std.count(key) == 1);
+  s21.insert(keys[0]);
+  EXPECT_TRUE(s21.contains(keys[0]));
+
+  auto copy = s21;
+  decltype(s21) other = {keys[1], keys[2], -1};
+  copy.merge(other);
+  EXPECT_TRUE(copy.contains(-1));
+  EXPECT_TRUE(copy.contains(keys[2]));
+  EXPECT_FALSE(s21.contains(-1));
+  EXPECT_EQ(other.size(), 0u);
+  EXPECT_FALSE(other.contains(keys[1]));
+  copy.clear();
+  EXPECT_FALSE(copy.contains(keys[0]));
+  copy.insert(5);
+  EXPECT_TRUE(copy.contains(5));
+
+  s21::multiset<std::string, std::less<std::string>, Filtered> words;
+  words.insert("alpha");
+  words.insert("alpha");
+  words.erase(words.find("alpha"));
+  EXPECT_TRUE(words.contains("alpha"));
+  EXPECT_FALSE(words.contains("beta"));
+}
+
+TEST(bounded_multiset, top_k) {
+  std::mt19937 gen(44);
+  s21::bounded_multiset<int> s21(100);
+  std::multiset<int> std;
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+    bool taken = std.size() < 100 || *std.begin() < key;
+    if (taken) {
+      if (std.size() == 100) std.erase(std.begin());
+      std.insert(key);
+    }
+    auto res = s21.insert(key);
+    ASSERT_EQ(res.second, taken);
+    if (taken) {
+      EXPECT_EQ(*res.first, key);
+    }
+    ASSERT_EQ(s21.threshold(), *std.begin());
+  }
+  EXPECT_TRUE(s21.full());
+  EXPECT_TRUE(std::equal(s21.begin(), s21.end(), std.begin(), std.end()));
+  EXPECT_EQ(s21.count(*std.rbegin()), std.count(*std.rbegin()));
+  EXPECT_FALSE(s21.contains(s21.threshold() - 1));
+  EXPECT_TRUE(s21.find(s21.threshold() - 1) == s21.end());
+  EXPECT_TRUE(s21.contains(*std.rbegin()));
+
+  s21.erase(s21.begin());
+  std.erase(std.begin());
+  EXPECT_EQ(s21.threshold(), *std.begin());
+  EXPECT_FALSE(s21.full());
+  auto copy = s21;
+  EXPECT_TRUE(copy == s21);
+  EXPECT_EQ(copy.threshold(), s21.threshold());
+  s21.clear();
+  EXPECT_TRUE(s21.empty());
+  EXPECT_TRUE(s21.insert(1).second);
+  EXPECT_EQ(s21.threshold(), 1);
+
+  s21::bounded_multiset<std::string, std::greater<std::string>> smallest(2);
+  for (const char *word : {"delta", "alpha", "echo", "alpha", "bravo"}) {
+    smallest.insert(word);
+  }
+  EXPECT_EQ(smallest.size(), 2u);
+  EXPECT_EQ(smallest.threshold(), "alpha");
+  EXPECT_EQ(smallest.count("alpha"), 2u);
+
+  s21::bounded_multiset<int> none(0);
+  EXPECT_FALSE(none.insert(1).second);
+  EXPECT_TRUE(none.empty());
+}
+
+TEST(multiset, rank_policy) {
+  struct Ranked : s21::TreeOptions {
+    using rank_policy = s21::SubtreeRank;
+  };
+  struct RankedAVL : Ranked {
+    using balance_policy = s21::AVLBalance;
+  };
+  std::mt19937 gen(45);
+  s21::multiset<int, std::less<int>, Ranked> rb;
+  s21::multiset<int, std::less<int>, RankedAVL> avl;
+  std::multiset<int> std;
+  rb.set_lazy_erase(0.25);
+  for (int i = 0; i < 4000; ++i) {
+    int key = static_cast<int>(gen() % 500);
+    rb.insert(key);
+    avl.insert(key);
+    std.insert(key);
+    if (i % 3 == 0) {
+      int victim = static_cast<int>(gen() % 500);
+      auto it = std.find(victim);
+      if (it != std.end()) {
+        std.erase(it);
+        rb.erase(rb.find(victim));
+        avl.erase(avl.find(victim));
+      }
+    }
+  }
+  std::size_t k = 0;
+  for (auto it = std.begin(); it != std.end(); ++it, ++k) {
+    ASSERT_EQ(*rb.nth(k), *it);
+    ASSERT_EQ(*avl.nth(k), *it);
+  }
+  EXPECT_TRUE(rb.nth(k) == rb.end());
+  for (int key = -1; key <= 500; key += 7) {
+    auto expected = static_cast<std::size_t>(
+        std::distance(std.begin(), std.lower_bound(key)));
+    EXPECT_EQ(rb.rank(key), expected);
+    EXPECT_EQ(avl.rank(key), expected);
+  }
+
+  s21::RBTree<int, std::less<int>, Ranked> tree;
+  for (int i = 0; i < 1000; ++i) tree.InsertKey(i % 100, false);
+  EXPECT_TRUE(tree.IsBalanced());
+  for (int i = 0; i < 300; ++i) tree.Erase(tree.Select(gen() % tree.Size()));
+  EXPECT_TRUE(tree.IsBalanced());
+  decltype(tree) copy(tree);
+  EXPECT_TRUE(copy.IsBalanced());
+  copy.MergeMulti(tree);
+  EXPECT_TRUE(copy.IsBalanced());
+  EXPECT_EQ(*copy.Select(copy.Size() - 1), 99);
+}
+
+TEST(window_quantiles, sliding_window) {
+  std::mt19937 gen(45);
+  s21::window_quantiles<double> window(257);
+  std::deque<double> order;
+  for (int i = 0; i < 3000; ++i) {
+    double sample = static_cast<double>(gen() % 1000) / 10;
+    window.push(sample);
+    order.push_back(sample);
+    if (order.size() > 257) order.pop_front();
+    if (i % 50 == 0) {
+      std::vector<double> sorted(order.begin(), order.end());
+      std::sort(sorted.begin(), sorted.end());
+      ASSERT_EQ(window.size(), sorted.size());
+      EXPECT_EQ(window.median(), sorted[(sorted.size() - 1) / 2]);
+      EXPECT_EQ(window.quantile(0.99),
+                sorted[static_cast<std::size_t>(0.99 * (sorted.size() - 1))]);
+      EXPECT_EQ(window.quantile(0), sorted.front());
+      EXPECT_EQ(window.quantile(1), sorted.back());
+      EXPECT_THROW(window.quantile(std::nan("")), std::invalid_argument);
+      auto below = std::lower_bound(sorted.begin(), sorted.end(), 50.0);
+      EXPECT_EQ(window.rank(50.0),
+                static_cast<std::size_t>(below - sorted.begin()));
+    }
+  }
+
+  // пакет длиннее окна собирает окно заново, короткий - сдвигает
+  std::vector<double> batch(1000);
+  for (auto &sample : batch) sample = static_cast<double>(gen() % 100);
+  window.advance(batch.begin(), batch.end());
+  order.assign(batch.end() - 257, batch.end());
+  window.advance(batch.begin(), batch.begin() + 100);
+  order.insert(order.end(), batch.begin(), batch.begin() + 100);
+  order.erase(order.begin(), order.begin() + 100);
+  for (int i = 0; i < 57; ++i) {
+    window.pop();
+    order.pop_front();
+  }
+  std::vector<double> sorted(order.begin(), order.end());
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_TRUE(std::equal(window.begin(), window.end(), sorted.begin(),
+                         sorted.end()));
+  for (std::size_t k = 0; k < sorted.size(); ++k) {
+    EXPECT_EQ(window.nth(k), sorted[k]);
+  }
+  EXPECT_THROW(window.nth(sorted.size()), std::out_of_range);
+  EXPECT_THROW(window.erase(1.0), std::logic_error);
+
+  s21::window_quantiles<int> manual;
+  EXPECT_THROW(manual.median(), std::out_of_range);
+  for (int i : {5, 1, 4, 1, 3}) manual.push(i);
+  EXPECT_EQ(manual.median(), 3);
+  EXPECT_TRUE(manual.erase(1));
+  EXPECT_FALSE(manual.erase(2));
+  EXPECT_EQ(manual.nth(0), 1);
+  EXPECT_EQ(manual.median(), 3);
+  auto moved = std::move(manual);
+  EXPECT_EQ(moved.size(), 4u);
+  EXPECT_TRUE(manual.empty());
+}
+
+TEST(sharded_multiset, concurrent_ingest) {
+  const std::size_t threads = 4, per_thread = 5000;
+  s21::sharded_multiset<std::string> sharded(threads);
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&sharded, t] {
+      std::mt19937 gen(static_cast<unsigned>(46 + t));
+      for (std::size_t i = 0; i < per_thread; ++i) {
+        sharded.insert(t, "token" + std::to_string(gen() % 700));
+      }
+    });
+  }
+  for (auto &worker : workers) worker.join();
+  std::multiset<std::string> std;
+  for (std::size_t t = 0; t < threads; ++t) {
+    std::mt19937 gen(static_cast<unsigned>(46 + t));
+    for (std::size_t i = 0; i < per_thread; ++i) {
+      std.insert("token" + std::to_string(gen() % 700));
+    }
+  }
+  EXPECT_EQ(sharded.size(), std.size());
+  EXPECT_EQ(sharded.count("token7"), std.count("token7"));
+  EXPECT_FALSE(sharded.contains("token700"));
+  EXPECT_EQ(*sharded.lower_bound("token5"), *std.lower_bound("token5"));
+  EXPECT_EQ(sharded.shard(1).size(), 0u);
+  EXPECT_TRUE(std::equal(sharded.begin(), sharded.end(), std.begin(),
+                         std.end()));
+  // end(), взятый до слияния, остаётся концом объединённого содержимого
+  s21::sharded_multiset<int> fresh(2);
+  auto fresh_end = fresh.end();
+  fresh.insert(0, 2);
+  fresh.insert(1, 1);
+  std::vector<int> walked;
+  for (auto it = fresh.begin(); it != fresh_end && walked.size() < 3; ++it) {
+    walked.push_back(*it);
+  }
+  EXPECT_EQ(walked, std::vector<int>({1, 2}));
+  EXPECT_TRUE(fresh.find(3) == fresh_end);
+  sharded.insert(2, "token7");
+  std.insert("token7");
+  EXPECT_EQ(sharded.count("token7"), std.count("token7"));
+  EXPECT_EQ(*sharded.upper_bound("token6"), *std.upper_bound("token6"));
+  EXPECT_TRUE(sharded.find("token700") == sharded.end());
+  EXPECT_EQ(sharded.size(), std.size());
+  sharded.clear();
+  EXPECT_TRUE(sharded.empty());
+}
+
+TEST(multiset, merge_linear) {
+  std::mt19937 gen(46);
+  s21::RBTree<int> left, right;
+  std::multiset<int> std;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 1000);
+    (i % 3 ? left : right).InsertKey(key, false);
+    std.insert(key);
+  }
+  right.SetLazyErase(0.5);
+  for (int i = 0; i < 100; ++i) {
+    auto it = right.Find(static_cast<int>(gen() % 1000));
+    if (it != right.End()) {
+      std.erase(std.find(*it));
+      right.Erase(it);
+    }
+  }
+  left.MergeLinear(right);
+  EXPECT_EQ(right.Size(), 0u);
+  EXPECT_TRUE(right.Begin() == right.End());
+  EXPECT_EQ(left.Size(), std.size());
+  EXPECT_TRUE(left.IsBalanced());
+  EXPECT_TRUE(std::equal(left.Begin(), left.End(), std.begin(), std.end()));
+  right.InsertKey(5, false);
+  left.MergeLinear(right);
+  std.insert(5);
+  EXPECT_TRUE(std::equal(left.Begin(), left.End(), std.begin(), std.end()));
+
+  struct Arena : s21::TreeOptions {
+    using allocation_policy = s21::HugePageArena;
+  };
+  s21::multiset<int, std::less<int>, Arena> a = {3, 1, 2}, b = {2, 4};
+  a.merge_linear(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.size(), 5u);
+  EXPECT_EQ(a.count(2), 2u);
+}
+
+TEST(set, write_buffer) {
+  struct Fingerprinted : s21::TreeOptions {
+    using fingerprint_policy = s21::HashFingerprint;
+  };
+  std::mt19937 gen(47);
+  s21::set<int, std::less<int>, Fingerprinted> buffered, plain;
+  s21::multiset<int> buffered_multi;
+  std::set<int> std;
+  std::multiset<int> std_multi;
+  buffered.set_write_buffer(64);
+  buffered_multi.set_write_buffer(64);
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    buffered.insert_buffered(key);
+    plain.insert(key);
+    buffered_multi.insert_buffered(key);
+    std.insert(key);
+    std_multi.insert(key);
+    // точечный поиск видит ключ до вливания буфера
+    if (i % 97 == 0) {
+      ASSERT_TRUE(buffered.contains(key));
+      ASSERT_TRUE(buffered_multi.contains(key));
+    }
+  }
+  EXPECT_EQ(buffered.fingerprint(), plain.fingerprint());
+  EXPECT_EQ(buffered.size(), std.size());
+  EXPECT_TRUE(buffered == plain);
+  EXPECT_TRUE(std::equal(buffered.begin(), buffered.end(), std.begin(),
+                         std.end()));
+  EXPECT_EQ(buffered_multi.size(), std_multi.size());
+  EXPECT_TRUE(std::equal(buffered_multi.begin(), buffered_multi.end(),
+                         std_multi.begin(), std_multi.end()));
+
+  // повтор ключа из буфера отклоняется обычной вставкой
+  buffered.insert_buffered(-5);
+  EXPECT_FALSE(buffered.insert(-5).second);
+  buffered.insert_buffered(-7);
+  buffered.insert_buffered(-7);
+  EXPECT_TRUE(buffered.contains(-7));
+  EXPECT_TRUE(buffered.find(-7) != buffered.end());
+  EXPECT_EQ(buffered.size(), std.size() + 2);
+  buffered_multi.insert_buffered(-7);
+  buffered_multi.insert_buffered(-7);
+  EXPECT_EQ(buffered_multi.count(-7), 2u);
+  s21::multiset<int> empty, pending;
+  pending.set_write_buffer(64);
+  pending.insert_buffered(1);
+  EXPECT_FALSE(empty == pending);
+  EXPECT_TRUE(empty != pending);
+
+  // ленивое удаление и копирование с непустым буфером
+  buffered_multi.set_lazy_erase(0.5);
+  for (int i = 0; i < 1000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    auto it = buffered_multi.find(key);
+    if (it != buffered_multi.end()) {
+      buffered_multi.erase(it);
+      std_multi.erase(std_multi.find(key));
+    }
+    buffered_multi.insert_buffered(key + 1);
+    std_multi.insert(key + 1);
+  }
+  auto copy = buffered_multi;
+  buffered_multi.insert_buffered(9999);
+  EXPECT_FALSE(copy.contains(9999));
+  // поиск по буферу ничего не меняет, его можно вызывать из разных потоков
+  const auto &shared = buffered_multi;
+  std::atomic<int> hits{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      for (int i = 0; i < 100; ++i) hits += shared.contains(9999);
+    });
+  }
+  for (auto &reader : readers) reader.join();
+  EXPECT_EQ(hits, 400);
+  std::vector<int> expected(std_multi.begin(), std_multi.end());
+  expected.insert(expected.begin(), {-7, -7});
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+  copy.set_write_buffer(0);
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  copy.insert_buffered(1);
+  EXPECT_EQ(copy.size(), 1u);
+}
+
+TEST(static_set, compile_time_lookup) {
+  constexpr auto keywords = s21::make_static_set<std::string_view>(
+      {"while", "if", "else", "for", "return", "do", "break", "if"});
+  static_assert(keywords.size() == 7);
+  static_assert(keywords.contains("return") && !keywords.contains("goto"));
+  static_assert(*keywords.begin() == "break");
+  static_assert(*keywords.lower_bound("g") == "if");
+  static_assert(keywords.upper_bound("while") == keywords.end());
+  static_assert(decltype(keywords)::kHashed);
+
+  // целые ключи: хэш для find, раскладка Эйтцингера для границ
+  std::mt19937 gen(48);
+  int raw[100];
+  std::set<int> std;
+  for (int &key : raw) {
+    key = static_cast<int>(gen() % 300) - 150;
+    std.insert(key);
+  }
+  s21::static_set<int, 100> ints(raw);
+  s21::static_set<int, 100, std::greater<int>> reversed(raw);
+  EXPECT_FALSE(decltype(reversed)::kHashed);
+  ASSERT_EQ(ints.size(), std.size());
+  EXPECT_TRUE(std::equal(ints.begin(), ints.end(), std.begin(), std.end()));
+  EXPECT_TRUE(std::equal(reversed.begin(), reversed.end(), std.rbegin(),
+                         std.rend()));
+  for (int key = -160; key < 160; ++key) {
+    EXPECT_EQ(ints.contains(key), std.count(key) == 1);
+    EXPECT_EQ(reversed.count(key), std.count(key));
+    auto it = ints.find(key);
+    EXPECT_TRUE(it == ints.end() || *it == key);
+    EXPECT_EQ(ints.lower_bound(key) - ints.begin(),
+              std::distance(std.begin(), std.lower_bound(key)));
+    EXPECT_EQ(ints.upper_bound(key) - ints.begin(),
+              std::distance(std.begin(), std.upper_bound(key)));
+  }
+}
+
+struct SplitAVL : s21::TreeOptions {
+  using balance_policy = s21::AVLBalance;
+};
+struct SplitRanked : s21::TreeOptions {
+  using rank_policy = s21::SubtreeRank;
+};
+struct SplitFingerprinted : s21::TreeOptions {
+  using fingerprint_policy = s21::HashFingerprint;
+  using filter_policy = s21::BloomFilter;
+};
+struct SplitRankedAVL : SplitAVL {
+  using rank_policy = s21::SubtreeRank;
+  using fingerprint_policy = s21::HashFingerprint;
+};
+struct SplitArena : s21::TreeOptions {
+  using allocation_policy = s21::HugePageArena;
+};
+
+template <typename Options>
+void CheckSplitJoin(unsigned seed) {
+  using Tree = s21::RBTree<int, std::less<int>, Options>;
+  std::mt19937 gen(seed);
+  Tree tree;
+  std::multiset<int> std;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    tree.InsertKey(key, false);
+    std.insert(key);
+  }
+  tree.SetLazyErase(0.5);
+  for (int i = 0; i < 200; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    auto it = std.find(key);
+    if (it != std.end()) {
+      std.erase(it);
+      tree.Erase(tree.Find(key));
+    }
+  }
+  const Tree whole(tree);
+  for (int key : {-1, 0, 1, 777, 1000, 1999, 2000, 5000}) {
+    Tree right;
+    tree.Split(key, right);
+    auto bound = std.lower_bound(key);
+    ASSERT_EQ(tree.Size(), static_cast<std::size_t>(
+                               std::distance(std.begin(), bound)));
+    ASSERT_EQ(right.Size(), static_cast<std::size_t>(
+                                std::distance(bound, std.end())));
+    EXPECT_TRUE(tree.IsBalanced());
+    EXPECT_TRUE(right.IsBalanced());
+    EXPECT_TRUE(std::equal(tree.Begin(), tree.End(), std.begin(), bound));
+    EXPECT_TRUE(std::equal(right.Begin(), right.End(), bound, std.end()));
+    EXPECT_TRUE(tree.Contains(key - 1) == (std.count(key - 1) > 0));
+    EXPECT_FALSE(tree.Contains(key));
+    EXPECT_TRUE(right.Contains(key) == (std.count(key) > 0));
+    // фильтры частей не перестраиваются, но ключей не теряют
+    for (int k : std) ASSERT_TRUE((k < key ? tree : right).Contains(k));
+    ASSERT_TRUE(tree.Join(right, false));
+    EXPECT_EQ(right.Size(), 0u);
+    EXPECT_TRUE(tree.IsBalanced());
+    EXPECT_TRUE(tree == whole);
+    for (int k : std) ASSERT_TRUE(tree.Contains(k));
+  }
+  // соединение деревьев разной высоты
+  Tree small;
+  for (int key = 3000; key < 3005; ++key) small.InsertKey(key, true);
+  EXPECT_FALSE(small.Join(tree, false));
+  ASSERT_TRUE(tree.Join(small, false));
+  EXPECT_TRUE(tree.IsBalanced());
+  EXPECT_EQ(tree.Size(), std.size() + 5);
+  Tree low;
+  low.InsertKey(-3, true);
+  ASSERT_TRUE(low.Join(tree, false));
+  EXPECT_TRUE(low.IsBalanced());
+  EXPECT_EQ(*low.Begin(), -3);
+  EXPECT_EQ(low.Size(), std.size() + 6);
+}
+
+TEST(set, split_join) {
+  CheckSplitJoin<s21::TreeOptions>(49);
+  CheckSplitJoin<SplitAVL>(50);
+  CheckSplitJoin<SplitRanked>(51);
+  CheckSplitJoin<SplitFingerprinted>(52);
+  CheckSplitJoin<SplitRankedAVL>(53);
+  CheckSplitJoin<SplitArena>(54);
+
+  s21::set<int> low = {5, 1, 9, 3, 7};
+  s21::set<int> high = low.split(5);
+  EXPECT_EQ(low.size(), 2u);
+  EXPECT_EQ(*high.begin(), 5);
+  EXPECT_THROW(high.join(low), std::invalid_argument);
+  EXPECT_EQ(high.size(), 3u);
+  low.insert(5);
+  EXPECT_THROW(low.join(high), std::invalid_argument);
+  low.erase(low.find(5));
+  low.join(high);
+  EXPECT_TRUE(high.empty());
+  EXPECT_TRUE(low == s21::set<int>({1, 3, 5, 7, 9}));
+
+  // равные ключи на границе мультимножества
+  s21::multiset<int> multi = {2, 2, 2, 1, 3};
+  s21::multiset<int> upper = multi.split(2);
+  EXPECT_EQ(multi.size(), 1u);
+  EXPECT_EQ(upper.count(2), 3u);
+  s21::multiset<int> three = upper.split(3);
+  upper.set_write_buffer(16);
+  upper.insert_buffered(2);
+  multi.join(upper);
+  multi.join(three);
+  EXPECT_TRUE(multi == s21::multiset<int>({1, 2, 2, 2, 2, 3}));
+}
+
+TEST(mapped_set, persistence) {
+  std::string path = testing::TempDir() + "s21_mapped_set_test.bin";
+  std::remove(path.c_str());
+  std::mt19937 gen(50);
+  std::set<int> std;
+  {
+    s21::mapped_set<int> set(path);
+    EXPECT_TRUE(set.empty());
+    for (int i = 0; i < 5000; ++i) {
+      int key = static_cast<int>(gen() % 20000);
+      auto res = set.insert(key);
+      EXPECT_EQ(res.second, std.insert(key).second);
+      EXPECT_EQ(*res.first, key);
+    }
+    set.sync();
+  }
+  s21::mapped_set<int> reader(path, true);
+  ASSERT_EQ(reader.size(), std.size());
+  EXPECT_TRUE(std::equal(reader.begin(), reader.end(), std.begin(), std.end()));
+  EXPECT_THROW(reader.insert(1), std::logic_error);
+  for (int key = -5; key < 20005; key += 13) {
+    EXPECT_EQ(reader.contains(key), std.count(key) == 1);
+    auto bound = std.lower_bound(key);
+    auto it = reader.lower_bound(key);
+    EXPECT_TRUE(bound == std.end() ? it == reader.end() : *it == *bound);
+    bound = std.upper_bound(key);
+    it = reader.upper_bound(key);
+    EXPECT_TRUE(bound == std.end() ? it == reader.end() : *it == *bound);
+  }
+
+  // писатель меняет только копии узлов: читатель видит свой снимок целым
+  std::set<int> old = std;
+  s21::mapped_set<int> writer(path);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 100000);
+    writer.insert(key);
+    std.insert(key);
+  }
+  EXPECT_TRUE(std::equal(writer.begin(), writer.end(), std.begin(),
+                         std.end()));
+  EXPECT_FALSE(reader.refresh());
+  writer.sync();
+  EXPECT_TRUE(std::equal(reader.begin(), reader.end(), old.begin(),
+                         old.end()));
+  EXPECT_TRUE(reader.refresh());
+  EXPECT_TRUE(std::equal(reader.begin(), reader.end(), std.begin(),
+                         std.end()));
+
+  // испорченный последний заголовок: открывается предыдущая версия
+  std::uint64_t version = writer.version();
+  writer.insert(-1);
+  writer.sync();
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    // слоты заголовка по 64 КиБ при любом размере страницы
+    std::uint64_t slot = (writer.version() % 2) * 65536;
+    file.seekp(static_cast<std::streamoff>(slot + 40));
+    file.write("torn", 4);
+  }
+  s21::mapped_set<int> recovered(path, true);
+  EXPECT_EQ(recovered.version(), version);
+  EXPECT_FALSE(recovered.contains(-1));
+  EXPECT_EQ(recovered.size(), std.size());
+
+  std::vector<int> sorted(1000);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  writer.assign_sorted(sorted.begin(), sorted.end());
+  writer.sync();
+  EXPECT_TRUE(reader.refresh());
+  EXPECT_TRUE(std::equal(reader.begin(), reader.end(), sorted.begin(),
+                         sorted.end()));
+
+  std::remove(path.c_str());
+
+  // уплотнение по собственным итераторам: файл растёт посреди копирования
+  s21::mapped_set<int> compacted(path);
+  std::size_t initial = compacted.file_size();
+  compacted.assign_sorted(sorted.begin(), sorted.end());
+  compacted.assign_sorted(sorted.begin(), sorted.end());
+  ASSERT_EQ(compacted.file_size(), initial);
+  compacted.assign_sorted(compacted.begin(), compacted.end());
+  EXPECT_GT(compacted.file_size(), initial);
+  EXPECT_TRUE(std::equal(compacted.begin(), compacted.end(), sorted.begin(),
+                         sorted.end()));
+  std::remove(path.c_str());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();